@@ -0,0 +1,241 @@
+/*
+ * Copyright 2021 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "mwcas_bench.hpp"
+
+namespace
+{
+using ::dbgroup::atomic::aopt::kMwCASCapacity;
+using ::dbgroup::atomic::aopt::component::kMaxRangeLength;
+using ::dbgroup::atomic::aopt::ReadPolicy;
+using ::dbgroup::atomic::aopt::bench::BenchConfig;
+using ::dbgroup::atomic::aopt::bench::Contention;
+using ::dbgroup::atomic::aopt::bench::ContiguousMode;
+using ::dbgroup::atomic::aopt::bench::MwCASBench;
+using ::dbgroup::atomic::aopt::bench::PairMode;
+
+/// a usage message of this benchmark
+constexpr char kUsage[] =
+    "usage: mwcas_aopt_bench [options]\n"
+    "  --threads=N     the number of worker threads (default: 1)\n"
+    "  --ops=N         the number of operations per thread (default: 1000000)\n"
+    "  --targets=N     the number of target words of each MwCAS (default: max capacity)\n"
+    "  --capacity=N    the capacity of descriptors (default: the number of targets); it\n"
+    "                  changes cache lines per descriptor, not the size of descriptor pages\n"
+    "  --fields=N      the number of words in a shared target array (default: 1000000)\n"
+    "  --read-ratio=N  the percentage of read operations (default: 0)\n"
+    "  --skew=F        a skew parameter of Zipf's law, 0 means uniform (default: 0)\n"
+    "  --read-policy=S helping or non-helping for active MwCAS (default: helping)\n"
+    "  --contention=S  eager, backoff, or randomized helping of active MwCAS (default: eager)\n"
+    "  --session=S     on: share one epoch guard in each read-modify-MwCAS (default: off)\n"
+    "  --pairs=S       none, wide (one 16-byte target), or split (two 8-byte targets):\n"
+    "                  update each target as a pair of words (default: none)\n"
+    "  --contiguous=S  off, words, or range: update contiguous words by word descriptors or\n"
+    "                  a range descriptor instead of random words (default: off)\n"
+    "  --scan=N        the number of contiguous words of each read operation (default: 1)\n"
+    "  --scan-method=S range or loop: read contiguous words by one ReadRange or a loop of\n"
+    "                  Read in one session (default: range)\n"
+    "  --placement=S   any or spread: place workers on NUMA nodes in a round-robin manner\n"
+    "                  (default: any)\n"
+    "  --seed=N        a random seed to prepare operations (default: random)\n";
+
+/**
+ * @brief Parse command line arguments.
+ *
+ * @param argc the number of arguments.
+ * @param argv command line arguments.
+ * @param config a struct to store parsed parameters.
+ * @retval true if all the arguments are valid.
+ * @retval false otherwise.
+ */
+auto
+ParseArgs(  //
+    const int argc,
+    char *argv[],
+    BenchConfig &config)  //
+    -> bool
+{
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg{argv[i]};
+    const auto pos = arg.find('=');
+    if (arg.rfind("--", 0) != 0 || pos == std::string::npos) return false;
+
+    const auto key = arg.substr(2, pos - 2);
+    const auto val = arg.substr(pos + 1);
+    if (key == "threads") {
+      config.thread_num = std::stoul(val);
+    } else if (key == "ops") {
+      config.exec_num = std::stoul(val);
+    } else if (key == "targets") {
+      config.target_num = std::stoul(val);
+    } else if (key == "capacity") {
+      config.capacity = std::stoul(val);
+    } else if (key == "fields") {
+      config.field_num = std::stoul(val);
+    } else if (key == "read-ratio") {
+      config.read_ratio = std::stoul(val);
+    } else if (key == "skew") {
+      config.skew = std::stod(val);
+    } else if (key == "read-policy") {
+      if (val == "helping") {
+        config.read_policy = ReadPolicy::HELPING;
+      } else if (val == "non-helping") {
+        config.read_policy = ReadPolicy::NON_HELPING;
+      } else {
+        return false;
+      }
+    } else if (key == "contention") {
+      if (val == "eager") {
+        config.contention = Contention::EAGER;
+      } else if (val == "backoff") {
+        config.contention = Contention::BACKOFF;
+      } else if (val == "randomized") {
+        config.contention = Contention::RANDOMIZED;
+      } else {
+        return false;
+      }
+    } else if (key == "session") {
+      if (val == "on") {
+        config.use_session = true;
+      } else if (val == "off") {
+        config.use_session = false;
+      } else {
+        return false;
+      }
+    } else if (key == "pairs") {
+      if (val == "none") {
+        config.pair_mode = PairMode::NONE;
+      } else if (val == "wide") {
+        config.pair_mode = PairMode::WIDE;
+      } else if (val == "split") {
+        config.pair_mode = PairMode::SPLIT;
+      } else {
+        return false;
+      }
+    } else if (key == "contiguous") {
+      if (val == "off") {
+        config.contiguous = ContiguousMode::OFF;
+      } else if (val == "words") {
+        config.contiguous = ContiguousMode::WORDS;
+      } else if (val == "range") {
+        config.contiguous = ContiguousMode::RANGE;
+      } else {
+        return false;
+      }
+    } else if (key == "scan") {
+      config.scan_num = std::stoul(val);
+    } else if (key == "scan-method") {
+      if (val == "range") {
+        config.use_range = true;
+      } else if (val == "loop") {
+        config.use_range = false;
+      } else {
+        return false;
+      }
+    } else if (key == "placement") {
+      if (val == "any") {
+        config.spread_nodes = false;
+      } else if (val == "spread") {
+        config.spread_nodes = true;
+      } else {
+        return false;
+      }
+    } else if (key == "seed") {
+      config.seed = std::stoul(val);
+    } else {
+      return false;
+    }
+  }
+
+  // validate parameters
+  if (config.thread_num == 0) {
+    std::cerr << "the number of threads must be positive.\n";
+    return false;
+  }
+  if (config.contiguous != ContiguousMode::OFF && config.pair_mode != PairMode::NONE) {
+    std::cerr << "contiguous words cannot be updated as pairs.\n";
+    return false;
+  }
+  // each pair uses two entries of a descriptor in any mode
+  const auto is_range = config.contiguous == ContiguousMode::RANGE;
+  const auto word_num = (config.pair_mode == PairMode::NONE) ? 1UL : 2UL;
+  const auto max_target_num = (is_range) ? kMaxRangeLength : kMwCASCapacity / word_num;
+  if (config.target_num == 0 || config.target_num > max_target_num) {
+    std::cerr << "the number of targets must be in [1, " << max_target_num << "].\n";
+    return false;
+  }
+  // a range descriptor does not depend on the capacity of normal descriptors
+  const auto min_capacity = (is_range) ? 1UL : config.target_num * word_num;
+  if (config.capacity == 0) {
+    config.capacity = std::min(min_capacity, kMwCASCapacity);
+  }
+  if (config.capacity < min_capacity || config.capacity > kMwCASCapacity) {
+    std::cerr << "the capacity must be in [" << min_capacity << ", " << kMwCASCapacity
+              << "].\n";
+    return false;
+  }
+  if (config.field_num < config.target_num) {
+    std::cerr << "the number of fields must not be less than the number of targets.\n";
+    return false;
+  }
+  if (config.read_ratio > 100) {
+    std::cerr << "the read ratio must be in [0, 100].\n";
+    return false;
+  }
+  if (config.scan_num == 0 || config.scan_num > config.field_num) {
+    std::cerr << "the number of scanned words must be in [1, " << config.field_num << "].\n";
+    return false;
+  }
+  if (config.scan_num > 1 && config.pair_mode != PairMode::NONE) {
+    std::cerr << "contiguous words cannot be read as pairs.\n";
+    return false;
+  }
+  if (config.skew < 0) {
+    std::cerr << "the skew parameter must not be negative.\n";
+    return false;
+  }
+
+  return true;
+}
+
+}  // namespace
+
+auto
+main(  //
+    int argc,
+    char *argv[])  //
+    -> int
+{
+  BenchConfig config{};
+  try {
+    if (!ParseArgs(argc, argv, config)) {
+      std::cerr << kUsage;
+      return EXIT_FAILURE;
+    }
+  } catch (const std::exception &) {
+    std::cerr << kUsage;
+    return EXIT_FAILURE;
+  }
+
+  MwCASBench{config}.Run();
+
+  return EXIT_SUCCESS;
+}
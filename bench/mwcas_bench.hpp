@@ -0,0 +1,765 @@
+/*
+ * Copyright 2021 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MWCAS_AOPT_BENCH_MWCAS_BENCH_H_
+#define MWCAS_AOPT_BENCH_MWCAS_BENCH_H_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#ifdef MWCAS_AOPT_USE_NUMA
+#include <numa.h>
+#endif
+
+#include "aopt/aopt_descriptor.hpp"
+#include "aopt/aopt_range_descriptor.hpp"
+#include "aopt/component/numa_utility.hpp"
+#include "zipf_generator.hpp"
+
+namespace dbgroup::atomic::aopt
+{
+namespace bench
+{
+/**
+ * @brief A struct to represent a pair of words updated at once.
+ *
+ * The most significant bit of the first word is reserved for MwCAS, and so benchmarks
+ * must not set it.
+ *
+ */
+struct alignas(16) Pair {
+  /// the first word
+  uint64_t first;
+
+  /// the second word
+  uint64_t second;
+};
+
+}  // namespace bench
+
+/**
+ * @brief Specialization to enable MwCAS to swap pairs as double-width targets.
+ *
+ */
+template <>
+constexpr auto
+CanMwCAS<bench::Pair>()  //
+    -> bool
+{
+  return true;
+}
+
+namespace bench
+{
+/*##################################################################################################
+ * Global enums and structs
+ *################################################################################################*/
+
+/**
+ * @brief An enumeration for representing contention managers to be compared.
+ *
+ */
+enum class Contention
+{
+  /// help active MwCAS operations immediately
+  EAGER = 0,
+  /// wait with exponential backoff before helping
+  BACKOFF,
+  /// wait for a random time before helping
+  RANDOMIZED
+};
+
+/**
+ * @brief An enumeration for representing how to update a pair of words.
+ *
+ */
+enum class PairMode
+{
+  /// each target is one 8-byte word
+  NONE = 0,
+  /// each target is a pair of words updated by one 16-byte target
+  WIDE,
+  /// each target is a pair of words updated by two 8-byte targets
+  SPLIT
+};
+
+/**
+ * @brief An enumeration for representing how to select and update target words.
+ *
+ */
+enum class ContiguousMode
+{
+  /// each MwCAS updates randomly selected words
+  OFF = 0,
+  /// each MwCAS updates contiguous words by a normal descriptor
+  WORDS,
+  /// each MwCAS updates contiguous words by a range descriptor
+  RANGE
+};
+
+/**
+ * @brief A struct to hold parameters of a benchmark.
+ *
+ */
+struct BenchConfig {
+  /// the number of worker threads
+  size_t thread_num{1};
+
+  /// the number of operations performed by each worker
+  size_t exec_num{1000000};
+
+  /// the number of target words (or pairs) of each MwCAS operation
+  size_t target_num{kMwCASCapacity};
+
+  /// the capacity of descriptors (zero means the same as the number of targets)
+  size_t capacity{0};
+
+  /// the number of words (or pairs) in a shared target array
+  size_t field_num{1000000};
+
+  /// the percentage of read operations
+  size_t read_ratio{0};
+
+  /// a skew parameter of Zipf's law (zero means a uniform distribution)
+  double skew{0};
+
+  /// a policy of read operations for active MwCAS operations
+  ReadPolicy read_policy{ReadPolicy::HELPING};
+
+  /// a contention manager used by workers
+  Contention contention{Contention::EAGER};
+
+  /// a flag to perform each read-modify-MwCAS sequence in one session
+  bool use_session{false};
+
+  /// a way to update targets as pairs of words
+  PairMode pair_mode{PairMode::NONE};
+
+  /// a way to select and update target words
+  ContiguousMode contiguous{ContiguousMode::OFF};
+
+  /// the number of contiguous words read by each read operation
+  size_t scan_num{1};
+
+  /// a flag to read contiguous words by ReadRange instead of a loop of Read
+  bool use_range{true};
+
+  /// a flag to place workers on NUMA nodes in a round-robin manner
+  bool spread_nodes{false};
+
+  /// a random seed to prepare operations
+  size_t seed{std::random_device{}()};
+};
+
+/**
+ * @brief A class to run MwCAS/read operations over multi-threads and report results.
+ *
+ */
+class MwCASBench
+{
+  /*################################################################################################
+   * Internal type aliases
+   *##############################################################################################*/
+
+  using Target = uint64_t;
+  using Clock = std::chrono::steady_clock;
+
+  /*################################################################################################
+   * Internal constants
+   *##############################################################################################*/
+
+  /// the names of contention managers
+  static constexpr const char *kContentionNames[] = {"eager", "backoff", "randomized"};
+
+  /// the names of modes to update pairs
+  static constexpr const char *kPairModeNames[] = {"none", "wide", "split"};
+
+  /// the names of modes to update contiguous words
+  static constexpr const char *kContiguousModeNames[] = {"off", "words", "range"};
+
+  /// a dummy node to represent that a worker can run on any node
+  static constexpr size_t kAnyNode = ~0UL;
+
+ public:
+  /*################################################################################################
+   * Public constructors and assignment operators
+   *##############################################################################################*/
+
+  /**
+   * @brief Construct a new benchmark with given parameters.
+   *
+   * @param config benchmark parameters.
+   */
+  explicit MwCASBench(const BenchConfig &config)
+      : config_{config},
+        fields_{std::make_unique<Target[]>(config.field_num * GetWordNum(config.pair_mode))}
+  {
+    // pairs are placed in 16-byte aligned slots of the array
+    static_assert(__STDCPP_DEFAULT_NEW_ALIGNMENT__ >= sizeof(Pair));
+  }
+
+  MwCASBench(const MwCASBench &) = delete;
+  MwCASBench &operator=(const MwCASBench &obj) = delete;
+  MwCASBench(MwCASBench &&) = delete;
+  MwCASBench &operator=(MwCASBench &&) = delete;
+
+  /*################################################################################################
+   * Public destructors
+   *##############################################################################################*/
+
+  /**
+   * @brief Destroy the MwCASBench object.
+   *
+   */
+  ~MwCASBench() = default;
+
+  /*################################################################################################
+   * Public utility functions
+   *##############################################################################################*/
+
+  /**
+   * @brief Run a benchmark and print its results to the standard output.
+   *
+   */
+  void
+  Run()
+  {
+    AOPTDescriptor<>::StartGC();
+
+    // run workers and measure the total execution time
+    std::vector<Result> results(config_.thread_num);
+    std::vector<std::thread> threads;
+    std::mt19937_64 rand_engine{config_.seed};
+    const auto worker = GetWorker(config_.contention, config_.capacity);
+    const auto node_num = component::GetNUMANodeNum();
+    for (size_t i = 0; i < config_.thread_num; ++i) {
+      const auto node = (config_.spread_nodes) ? i % node_num : kAnyNode;
+      threads.emplace_back(worker, this, rand_engine(), node, std::ref(results[i]));
+    }
+    while (ready_num_.load(std::memory_order_acquire) < config_.thread_num) {
+      std::this_thread::yield();
+    }
+    const auto start_time = Clock::now();
+    is_running_.store(true, std::memory_order_release);
+    for (auto &&t : threads) t.join();
+    const auto end_time = Clock::now();
+
+    AOPTDescriptor<>::StopGC();
+
+    // merge the results of workers
+    Result total{};
+    for (auto &&result : results) {
+      total.mwcas_success += result.mwcas_success;
+      total.mwcas_failure += result.mwcas_failure;
+      total.mwcas_latencies.insert(total.mwcas_latencies.end(),  //
+                                   result.mwcas_latencies.begin(), result.mwcas_latencies.end());
+      total.read_latencies.insert(total.read_latencies.end(),  //
+                                  result.read_latencies.begin(), result.read_latencies.end());
+    }
+    const auto exec_time =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count();
+
+    Print(total, exec_time);
+  }
+
+ private:
+  /*################################################################################################
+   * Internal structs
+   *##############################################################################################*/
+
+  /**
+   * @brief A struct to hold results of each worker.
+   *
+   */
+  struct Result {
+    /// the number of succeeded MwCAS operations
+    size_t mwcas_success{0};
+
+    /// the number of failed MwCAS operations
+    size_t mwcas_failure{0};
+
+    /// latencies of MwCAS operations in nanoseconds
+    std::vector<size_t> mwcas_latencies{};
+
+    /// latencies of read operations in nanoseconds
+    std::vector<size_t> read_latencies{};
+  };
+
+  /*################################################################################################
+   * Internal utility functions
+   *##############################################################################################*/
+
+  /**
+   * @param pair_mode a way to update targets as pairs of words.
+   * @return the number of words in each target.
+   */
+  static constexpr auto
+  GetWordNum(const PairMode pair_mode)  //
+      -> size_t
+  {
+    return (pair_mode == PairMode::NONE) ? 1 : 2;
+  }
+
+  /**
+   * @param contention a contention manager used by workers.
+   * @param capacity the capacity of descriptors.
+   * @return a worker function that uses descriptors with given parameters.
+   */
+  static constexpr auto
+  GetWorker(  //
+      const Contention contention,
+      const size_t capacity)  //
+      -> void (MwCASBench::*)(size_t, size_t, Result &)
+  {
+    switch (contention) {
+      case Contention::BACKOFF:
+        return GetWorker<ExponentialBackoff<>>(capacity);
+      case Contention::RANDOMIZED:
+        return GetWorker<RandomizedHelping<>>(capacity);
+      case Contention::EAGER:
+      default:
+        return GetWorker<EagerHelping>(capacity);
+    }
+  }
+
+  /**
+   * @tparam ContentionManager a contention manager used by workers.
+   * @tparam kCapacity the minimum capacity to be searched.
+   * @param capacity the capacity of descriptors.
+   * @return a worker function that uses descriptors with a given capacity.
+   */
+  template <class ContentionManager, size_t kCapacity = 1>
+  static constexpr auto
+  GetWorker(const size_t capacity)  //
+      -> void (MwCASBench::*)(size_t, size_t, Result &)
+  {
+    if constexpr (kCapacity < kMwCASCapacity) {
+      if (capacity > kCapacity) return GetWorker<ContentionManager, kCapacity + 1>(capacity);
+    }
+    return &MwCASBench::Worker<AOPTDescriptor<kCapacity, ContentionManager>,
+                               AOPTRangeDescriptor<ContentionManager>>;
+  }
+
+  /**
+   * @brief Prepare and perform operations in a worker thread.
+   *
+   * @tparam Descriptor a class of descriptors.
+   * @tparam RangeDescriptor a class of range descriptors.
+   * @param rand_seed a random seed to prepare operations.
+   * @param node a NUMA node to run this worker (kAnyNode if not specified).
+   * @param result a struct to store the results of this worker.
+   */
+  template <class Descriptor, class RangeDescriptor>
+  void
+  Worker(  //
+      const size_t rand_seed,
+      [[maybe_unused]] const size_t node,
+      Result &result)
+  {
+#ifdef MWCAS_AOPT_USE_NUMA
+    if (node != kAnyNode && component::GetNUMANodeNum() > 1) {
+      numa_run_on_node(static_cast<int>(node));
+    }
+#endif
+
+    const auto exec_num = config_.exec_num;
+    const auto target_num = config_.target_num;
+
+    // prepare operations in advance to exclude the cost of random number generation
+    std::vector<bool> is_read(exec_num);
+    std::vector<size_t> targets(exec_num * target_num);
+    std::vector<Target> scan_buf(config_.scan_num);
+    {
+      std::mt19937_64 rand_engine{rand_seed};
+      std::uniform_int_distribution<size_t> ratio_dist{0, 99};
+      ZipfGenerator id_gen{config_.field_num, config_.skew};
+      for (size_t i = 0; i < exec_num; ++i) {
+        is_read[i] = ratio_dist(rand_engine) < config_.read_ratio;
+
+        // select distinct target words in random order (the library sorts them by their
+        // addresses unless MWCAS_AOPT_UNSORTED_TARGETS is defined)
+        const auto begin = targets.begin() + i * target_num;
+        for (size_t j = 0; j < target_num; ++j) {
+          size_t id;
+          do {
+            id = id_gen(rand_engine);
+          } while (std::find(begin, begin + j, id) != begin + j);
+          begin[j] = id;
+        }
+      }
+      result.mwcas_latencies.reserve(exec_num);
+      result.read_latencies.reserve(exec_num);
+    }
+
+    // wait for a main thread to start a benchmark
+    ready_num_.fetch_add(1, std::memory_order_release);
+    while (!is_running_.load(std::memory_order_acquire)) {
+      std::this_thread::yield();
+    }
+
+    for (size_t i = 0; i < exec_num; ++i) {
+      const auto *ids = &(targets[i * target_num]);
+
+      if (is_read[i]) {
+        const auto start_time = Clock::now();
+        [[maybe_unused]] const auto val = (config_.scan_num > 1)
+                                              ? Scan<Descriptor>(ids[0], scan_buf.data())
+                                              : Read<Descriptor>(ids[0]);
+        const auto end_time = Clock::now();
+        result.read_latencies.emplace_back(ToNanoSec(start_time, end_time));
+        continue;
+      }
+
+      Clock::time_point start_time;
+      Clock::time_point end_time;
+      const auto update = [&](const auto &...session) {
+        if (config_.contiguous == ContiguousMode::OFF) {
+          return ReadModifyMwCAS<Descriptor>(ids, start_time, end_time, session...);
+        }
+        return ReadModifyRange<Descriptor, RangeDescriptor>(ids[0], start_time, end_time,
+                                                            session...);
+      };
+
+      auto success = false;
+      if (config_.use_session) {
+        const typename Descriptor::Session session{};
+        success = update(session);
+      } else {
+        success = update();
+      }
+      result.mwcas_latencies.emplace_back(ToNanoSec(start_time, end_time));
+      if (success) {
+        ++result.mwcas_success;
+      } else {
+        ++result.mwcas_failure;
+      }
+    }
+  }
+
+  /**
+   * @brief Increment target words by MwCAS and measure the time of MwCAS.
+   *
+   * @tparam Descriptor a class of descriptors.
+   * @tparam Session an optional session class.
+   * @param ids the indices of target words.
+   * @param start_time the time when MwCAS starts.
+   * @param end_time the time when MwCAS ends.
+   * @param session an optional session for all the operations.
+   * @retval true if MwCAS succeeds.
+   * @retval false otherwise.
+   */
+  template <class Descriptor, class... Session>
+  auto
+  ReadModifyMwCAS(  //
+      const size_t *ids,
+      Clock::time_point &start_time,
+      Clock::time_point &end_time,
+      const Session &...session)  //
+      -> bool
+  {
+    // register MwCAS targets
+    auto *desc = Descriptor::GetDescriptor();
+    for (size_t j = 0; j < config_.target_num; ++j) {
+      switch (config_.pair_mode) {
+        case PairMode::WIDE: {
+          auto *addr = &(fields_[2 * ids[j]]);
+          const auto cur = Descriptor::template Read<Pair>(addr, session...);
+          desc->AddMwCASTarget(addr, cur, Pair{cur.first + 1, cur.second + 1});
+          break;
+        }
+        case PairMode::SPLIT:
+          for (auto *addr : {&(fields_[2 * ids[j]]), &(fields_[2 * ids[j] + 1])}) {
+            const auto cur_val = Descriptor::template Read<Target>(addr, session...);
+            desc->AddMwCASTarget(addr, cur_val, cur_val + 1);
+          }
+          break;
+        case PairMode::NONE:
+        default: {
+          auto *addr = &(fields_[ids[j]]);
+          const auto cur_val = Descriptor::template Read<Target>(addr, session...);
+          desc->AddMwCASTarget(addr, cur_val, cur_val + 1);
+        }
+      }
+    }
+
+    // perform MwCAS
+    start_time = Clock::now();
+    const auto success = desc->MwCAS(session...);
+    end_time = Clock::now();
+
+    return success;
+  }
+
+  /**
+   * @brief Increment contiguous target words by MwCAS and measure the time of MwCAS.
+   *
+   * @tparam Descriptor a class of descriptors.
+   * @tparam RangeDescriptor a class of range descriptors.
+   * @tparam Session an optional session class.
+   * @param id the index of the first target word (the range is shifted to fit the array).
+   * @param start_time the time when MwCAS starts.
+   * @param end_time the time when MwCAS ends.
+   * @param session an optional session for all the operations.
+   * @retval true if MwCAS succeeds.
+   * @retval false otherwise.
+   */
+  template <class Descriptor, class RangeDescriptor, class... Session>
+  auto
+  ReadModifyRange(  //
+      const size_t id,
+      Clock::time_point &start_time,
+      Clock::time_point &end_time,
+      const Session &...session)  //
+      -> bool
+  {
+    // read the target words in bulk
+    const auto target_num = config_.target_num;
+    auto *addr = &(fields_[std::min(id, config_.field_num - target_num)]);
+    std::array<Target, component::kMaxRangeLength> old_vals;
+    std::array<Target, component::kMaxRangeLength> new_vals;
+    Descriptor::template ReadRange<Target>(addr, target_num, old_vals.data(), session...);
+    for (size_t j = 0; j < target_num; ++j) {
+      new_vals[j] = old_vals[j] + 1;
+    }
+
+    // perform MwCAS by a range descriptor or word descriptors for each word
+    auto success = false;
+    if (config_.contiguous == ContiguousMode::RANGE) {
+      auto *desc = RangeDescriptor::GetDescriptor();
+      desc->SetMwCASRange(addr, old_vals.data(), new_vals.data(), target_num);
+      start_time = Clock::now();
+      success = desc->MwCAS(session...);
+      end_time = Clock::now();
+    } else {
+      auto *desc = Descriptor::GetDescriptor();
+      for (size_t j = 0; j < target_num; ++j) {
+        desc->AddMwCASTarget(addr + j, old_vals[j], new_vals[j]);
+      }
+      start_time = Clock::now();
+      success = desc->MwCAS(session...);
+      end_time = Clock::now();
+    }
+
+    return success;
+  }
+
+  /**
+   * @tparam Descriptor a class of descriptors.
+   * @param id the index of a target word (or pair).
+   * @return a value (or the sum of a pair) read with the specified policy.
+   */
+  template <class Descriptor>
+  auto
+  Read(const size_t id) const  //
+      -> Target
+  {
+    switch (config_.pair_mode) {
+      case PairMode::WIDE: {
+        const auto pair = Read<Descriptor, Pair>(&(fields_[2 * id]));
+        return pair.first + pair.second;
+      }
+      case PairMode::SPLIT:
+        return Read<Descriptor, Target>(&(fields_[2 * id]))
+               + Read<Descriptor, Target>(&(fields_[2 * id + 1]));
+      case PairMode::NONE:
+      default:
+        return Read<Descriptor, Target>(&(fields_[id]));
+    }
+  }
+
+  /**
+   * @brief Read contiguous target words from a given index.
+   *
+   * @tparam Descriptor a class of descriptors.
+   * @param id the index of a target word (the range is shifted to fit the array).
+   * @param buf an output buffer for read values.
+   * @return the last read value.
+   */
+  template <class Descriptor>
+  auto
+  Scan(  //
+      const size_t id,
+      Target *buf) const  //
+      -> Target
+  {
+    const auto scan_num = config_.scan_num;
+    auto *addr = &(fields_[std::min(id, config_.field_num - scan_num)]);
+    if (config_.use_range) {
+      if (config_.read_policy == ReadPolicy::NON_HELPING) {
+        Descriptor::template ReadRange<Target, ReadPolicy::NON_HELPING>(addr, scan_num, buf);
+      } else {
+        Descriptor::template ReadRange<Target>(addr, scan_num, buf);
+      }
+    } else {
+      const typename Descriptor::Session session{};
+      for (size_t i = 0; i < scan_num; ++i) {
+        if (config_.read_policy == ReadPolicy::NON_HELPING) {
+          buf[i] = Descriptor::template Read<Target, ReadPolicy::NON_HELPING>(addr + i, session);
+        } else {
+          buf[i] = Descriptor::template Read<Target>(addr + i, session);
+        }
+      }
+    }
+    return buf[scan_num - 1];
+  }
+
+  /**
+   * @tparam Descriptor a class of descriptors.
+   * @tparam T a class of a target.
+   * @param addr a target address.
+   * @return a value read with the specified policy.
+   */
+  template <class Descriptor, class T>
+  auto
+  Read(void *addr) const  //
+      -> T
+  {
+    if (config_.read_policy == ReadPolicy::NON_HELPING) {
+      return Descriptor::template Read<T, ReadPolicy::NON_HELPING>(addr);
+    }
+    return Descriptor::template Read<T>(addr);
+  }
+
+  /**
+   * @brief Print the results of a benchmark.
+   *
+   * @param result merged results of all the workers.
+   * @param exec_time the total execution time in nanoseconds.
+   */
+  void
+  Print(  //
+      Result &result,
+      const size_t exec_time) const
+  {
+    const auto mwcas_num = result.mwcas_success + result.mwcas_failure;
+    const auto op_num = mwcas_num + result.read_latencies.size();
+    const auto throughput = static_cast<double>(op_num) / exec_time * 1e9;
+
+    std::cout << "threads: " << config_.thread_num << ", capacity: " << config_.capacity
+              << " (page: " << component::kDescriptorPageSize << " B)"
+              << ", targets: " << config_.target_num << ", fields: " << config_.field_num
+              << ", skew: " << config_.skew << ", read ratio: " << config_.read_ratio << "%"
+              << ", read policy: "
+              << (config_.read_policy == ReadPolicy::HELPING ? "helping" : "non-helping")
+              << ", contention: " << kContentionNames[static_cast<size_t>(config_.contention)]
+              << ", session: " << (config_.use_session ? "on" : "off")
+              << ", pairs: " << kPairModeNames[static_cast<size_t>(config_.pair_mode)]
+              << ", contiguous: "
+              << kContiguousModeNames[static_cast<size_t>(config_.contiguous)]
+              << ", scan: " << config_.scan_num << " (" << (config_.use_range ? "range" : "loop")
+              << ")"
+              << ", NUMA nodes: " << component::GetNUMANodeNum()
+              << ", placement: " << (config_.spread_nodes ? "spread" : "any")
+              << ", target order: " << (kSortTargets ? "address" : "registration") << "\n";
+    std::cout << "throughput [ops/s]: " << throughput << "\n";
+    if (mwcas_num > 0) {
+      std::cout << "MwCAS success rate: " << 100.0 * result.mwcas_success / mwcas_num  //
+                << "%, failure rate: " << 100.0 * result.mwcas_failure / mwcas_num << "%\n";
+    }
+    PrintLatency("MwCAS", result.mwcas_latencies);
+    PrintLatency("Read", result.read_latencies);
+
+    const auto pool_stats = AOPTDescriptor<>::GetPoolStatistics();
+    if (pool_stats.get_num > 0) {
+      std::cout << "descriptor pool hit rate: " << 100.0 * pool_stats.hit_num / pool_stats.get_num
+                << "%, reused pages: " << pool_stats.reuse_num
+                << ", allocated pages: " << pool_stats.alloc_num
+                << ", pages from node pools: " << pool_stats.node_reuse_num
+                << ", reclaimed pages on remote nodes (proxy for cross-node traffic): "
+                << pool_stats.remote_num << "\n";
+    }
+
+    if constexpr (kEnableStatistics) {
+      const auto stats = AOPTDescriptor<>::GetStatistics();
+      std::cout << "MwCAS events: operation retries " << stats.retry_num
+                << ", embedding failures " << stats.embed_failure_num
+                << ", helps " << stats.help_num  //
+                << ", max helping depth " << stats.max_help_depth
+                << ", helping limits " << stats.help_limit_num
+                << ", pre-validation failures " << stats.pre_validation_failure_num
+                << ", unpublished failures " << stats.unpublished_failure_num << "\n";
+      if (stats.finalize_num > 0) {
+        std::cout << "finalized descriptors: average batch "
+                  << static_cast<double>(stats.finalized_desc_num) / stats.finalize_num
+                  << ", max batch " << stats.max_finalize_size << "\n";
+      }
+    }
+  }
+
+  /**
+   * @brief Print percentiles of given latencies.
+   *
+   * @param label a label of the target operation.
+   * @param latencies latencies in nanoseconds.
+   */
+  static void
+  PrintLatency(  //
+      const char *label,
+      std::vector<size_t> &latencies)
+  {
+    if (latencies.empty()) return;
+
+    std::cout << label << " latency [ns]:";
+    for (auto &&[name, percentile] : {std::make_pair("p50", 0.5),  //
+                                      std::make_pair("p99", 0.99),
+                                      std::make_pair("p999", 0.999)}) {
+      const auto pos = static_cast<size_t>((latencies.size() - 1) * percentile);
+      std::nth_element(latencies.begin(), latencies.begin() + pos, latencies.end());
+      std::cout << " " << name << " " << latencies[pos];
+    }
+    std::cout << "\n";
+  }
+
+  /**
+   * @return the elapsed time between given time points in nanoseconds.
+   */
+  static auto
+  ToNanoSec(  //
+      const Clock::time_point start_time,
+      const Clock::time_point end_time)  //
+      -> size_t
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count();
+  }
+
+  /*################################################################################################
+   * Internal member variables
+   *##############################################################################################*/
+
+  /// benchmark parameters
+  const BenchConfig config_{};
+
+  /// shared target words of MwCAS operations
+  std::unique_ptr<Target[]> fields_{};
+
+  /// the number of workers that have finished preparation
+  std::atomic_size_t ready_num_{0};
+
+  /// a flag to start a benchmark
+  std::atomic_bool is_running_{false};
+};
+
+}  // namespace bench
+}  // namespace dbgroup::atomic::aopt
+
+#endif  // MWCAS_AOPT_BENCH_MWCAS_BENCH_H_
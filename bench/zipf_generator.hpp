@@ -0,0 +1,121 @@
+/*
+ * Copyright 2021 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MWCAS_AOPT_BENCH_ZIPF_GENERATOR_H_
+#define MWCAS_AOPT_BENCH_ZIPF_GENERATOR_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace dbgroup::atomic::aopt::bench
+{
+/**
+ * @brief A class to generate IDs according to Zipf's law.
+ *
+ * If a skew parameter is zero, this generator returns uniformly distributed IDs.
+ *
+ */
+class ZipfGenerator
+{
+ public:
+  /*################################################################################################
+   * Public constructors and assignment operators
+   *##############################################################################################*/
+
+  /**
+   * @brief Construct a new generator.
+   *
+   * @param id_num the number of IDs to be generated (i.e., IDs are in [0, id_num)).
+   * @param alpha a skew parameter (zero means a uniform distribution).
+   */
+  ZipfGenerator(  //
+      const size_t id_num,
+      const double alpha)
+      : id_num_{id_num}, alpha_{alpha}
+  {
+    if (alpha_ == 0) return;
+
+    // compute a cumulative distribution function to sample IDs by binary search
+    cdf_.reserve(id_num_);
+    double sum = 0;
+    for (size_t i = 1; i <= id_num_; ++i) {
+      sum += 1.0 / std::pow(static_cast<double>(i), alpha_);
+      cdf_.emplace_back(sum);
+    }
+    for (auto &&prob : cdf_) {
+      prob /= sum;
+    }
+  }
+
+  ZipfGenerator(const ZipfGenerator &) = default;
+  ZipfGenerator &operator=(const ZipfGenerator &obj) = default;
+  ZipfGenerator(ZipfGenerator &&) = default;
+  ZipfGenerator &operator=(ZipfGenerator &&) = default;
+
+  /*################################################################################################
+   * Public destructors
+   *##############################################################################################*/
+
+  /**
+   * @brief Destroy the ZipfGenerator object.
+   *
+   */
+  ~ZipfGenerator() = default;
+
+  /*################################################################################################
+   * Public operators
+   *##############################################################################################*/
+
+  /**
+   * @tparam RandEngine a class of random engines.
+   * @param rand_engine a random engine to generate IDs.
+   * @return an ID in [0, id_num).
+   */
+  template <class RandEngine>
+  auto
+  operator()(RandEngine &rand_engine)  //
+      -> size_t
+  {
+    if (alpha_ == 0) {
+      return std::uniform_int_distribution<size_t>{0, id_num_ - 1}(rand_engine);
+    }
+
+    const auto prob = std::uniform_real_distribution<double>{0, 1}(rand_engine);
+    const auto iter = std::lower_bound(cdf_.begin(), cdf_.end(), prob);
+    return std::min<size_t>(std::distance(cdf_.begin(), iter), id_num_ - 1);
+  }
+
+ private:
+  /*################################################################################################
+   * Internal member variables
+   *##############################################################################################*/
+
+  /// the number of IDs
+  size_t id_num_{};
+
+  /// a skew parameter
+  double alpha_{};
+
+  /// a cumulative distribution function of Zipf's law
+  std::vector<double> cdf_{};
+};
+
+}  // namespace dbgroup::atomic::aopt::bench
+
+#endif  // MWCAS_AOPT_BENCH_ZIPF_GENERATOR_H_
@@ -18,38 +18,44 @@
 #define MWCAS_AOPT_AOPT_COMPONENT_AOPT_DESCRIPTOR_H_
 
 #include <array>
-#include <atomic>
-#include <memory>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 
-#include "component/word_descriptor.hpp"
-#include "memory/epoch_based_gc.hpp"
+#include "component/descriptor_base.hpp"
+#include "contention_manager.hpp"
 
 namespace dbgroup::atomic::aopt
 {
+class MwCASDomain;
+
 /**
  * @brief A class to manage a MwCAS (multi-words compare-and-swap) operation by using
  * AOPT algorithm.
  *
+ * Descriptors of different capacities can coexist and update the same words because
+ * they share GC and the helping procedure. Note that each descriptor only touches cache
+ * lines for its own capacity, but it occupies a memory page sized for kMwCASCapacity.
+ * Thus, a small capacity does not reduce memory usage.
+ *
+ * @tparam kCapacity the maximum number of target words of this descriptor.
+ * @tparam ContentionManager a class to decide when to help active MwCAS operations and
+ * how to wait for retries (e.g., EagerHelping, ExponentialBackoff, and RandomizedHelping).
  */
-class alignas(component::kCacheLineSize) AOPTDescriptor
+template <size_t kCapacity = kMwCASCapacity, class ContentionManager = EagerHelping>
+class alignas(component::kCacheLineSize) AOPTDescriptor : public component::DescriptorBase
 {
-  using EpochBasedGC_t = ::dbgroup::memory::EpochBasedGC<AOPTDescriptor>;
-  using Status = component::Status;
   using WordDescriptor = component::WordDescriptor;
-  using MwCASField = component::MwCASField;
 
  public:
   /*################################################################################################
    * Public constructors and assignment operators
    *##############################################################################################*/
 
-  /**
-   * @brief Construct an empty descriptor for MwCAS operations.
-   *
-   */
-  constexpr AOPTDescriptor() = default;
-
   AOPTDescriptor(const AOPTDescriptor &) = delete;
   AOPTDescriptor &operator=(const AOPTDescriptor &obj) = delete;
   AOPTDescriptor(AOPTDescriptor &&) = delete;
@@ -66,333 +72,795 @@ class alignas(component::kCacheLineSize) AOPTDescriptor
   ~AOPTDescriptor() = default;
 
   /*################################################################################################
-   * Public getters/setters
+   * Public utility functions
    *##############################################################################################*/
 
   /**
-   * @return the number of registered MwCAS targets.
+   * @return Get a new MwCAS descriptor for the AOPT algorithm in the default domain.
+   *
+   * Note that this function takes a descriptor from a thread-local pool, which is
+   * refilled with descriptors released by GC in bulk.
    */
-  [[nodiscard]] constexpr auto
-  Size() const  //
-      -> size_t
+  static auto
+  GetDescriptor()  //
+      -> AOPTDescriptor *
   {
-    return target_count_;
+    return GetDescriptor(component::kDefaultDomainID);
   }
 
   /**
-   * @return the current status of this descriptor.
+   * @brief Read a value from a given memory address by using the contention manager of
+   * this class.
+   *
+   * Note that a 16-byte target is read by lock cmpxchg16b unless built with AVX (see
+   * DescriptorBase::Read).
+   *
+   * @tparam T an expected class of a target field
+   * @tparam kPolicy a policy for active MwCAS operations
+   * @param addr a target memory address to read
+   * @return a read value
    */
-  [[nodiscard]] auto
-  GetStatus() const  //
-      -> Status
+  template <class T, ReadPolicy kPolicy = ReadPolicy::HELPING>
+  static auto
+  Read(void *addr)  //
+      -> T
   {
-    return status_.load(std::memory_order_relaxed);
+    return DescriptorBase::Read<T, kPolicy, ContentionManager>(addr);
   }
 
-  /*################################################################################################
-   * Public utility functions
-   *##############################################################################################*/
-
   /**
-   * @brief Start garbage collection for AOPT descriptors.
+   * @brief Read a value from a given memory address in a given session.
    *
-   * Note that this function must be called before performing AOPT-based MwCAS.
+   * @tparam T an expected class of a target field
+   * @tparam kPolicy a policy for active MwCAS operations
+   * @param addr a target memory address to read
+   * @param session a session that protects descriptors in the target address
+   * @return a read value
+   */
+  template <class T, ReadPolicy kPolicy = ReadPolicy::HELPING>
+  static auto
+  Read(  //
+      void *addr,
+      const Session &session)  //
+      -> T
+  {
+    return DescriptorBase::Read<T, kPolicy, ContentionManager>(addr, session);
+  }
+
+  /**
+   * @brief Read values from contiguous target words (see DescriptorBase::ReadRange).
    *
-   * @param gc_interval interval for GC in microseconds.
-   * @param gc_thread_num the number of worker threads to release garbages.
+   * @tparam T an expected class of target fields
+   * @tparam kPolicy a policy for active MwCAS operations
+   * @param addr the address of the first target word
+   * @param n the number of target words to read
+   * @param out an output array for read values
    */
+  template <class T, ReadPolicy kPolicy = ReadPolicy::HELPING>
   static void
-  StartGC(  //
-      const size_t gc_interval = 100000,
-      const size_t gc_thread_num = 1)
+  ReadRange(  //
+      void *addr,
+      const size_t n,
+      T *out)
   {
-    gc_ = std::make_unique<EpochBasedGC_t>(gc_interval, gc_thread_num, true);
+    DescriptorBase::ReadRange<T, kPolicy, ContentionManager>(addr, n, out);
   }
 
   /**
-   * @brief Stop garbage collection for AOPT descriptors.
+   * @brief Read values from contiguous target words in a given session.
    *
+   * @tparam T an expected class of target fields
+   * @tparam kPolicy a policy for active MwCAS operations
+   * @param addr the address of the first target word
+   * @param n the number of target words to read
+   * @param out an output array for read values
+   * @param session a session that protects descriptors in the target addresses
    */
+  template <class T, ReadPolicy kPolicy = ReadPolicy::HELPING>
   static void
-  StopGC()
+  ReadRange(  //
+      void *addr,
+      const size_t n,
+      T *out,
+      const Session &session)
   {
-    gc_.reset(nullptr);
+    DescriptorBase::ReadRange<T, kPolicy, ContentionManager>(addr, n, out, session);
   }
 
   /**
-   * @return Get a new MwCAS descriptor for the AOPT algorithm.
+   * @brief Read the values of multiple targets that coexisted at a certain moment.
+   *
+   * This function does not allocate any descriptor, and so it is cheaper than a MwCAS
+   * operation that only compares targets (see DescriptorBase::ReadSnapshot for the
+   * requirement on targets). For example, `auto [hdr, next] =
+   * AOPTDescriptor<>::ReadSnapshot<Header, Node *>(&hdr_field, &next_field)`.
    *
-   * Note that this function tries to reuse descriptors released by GC.
+   * @tparam Ts classes of target fields
+   * @param addrs target memory addresses to read
+   * @return a tuple of read values
    */
+  template <class... Ts>
   static auto
-  GetDescriptor()  //
-      -> AOPTDescriptor *
+  ReadSnapshot(TargetAddress<Ts>... addrs)  //
+      -> std::tuple<Ts...>
   {
-    auto *page = gc_->GetPageIfPossible<AOPTDescriptor>();
-    auto *desc = (page == nullptr) ? new AOPTDescriptor{} : new (page) AOPTDescriptor{};
-    return desc;
+    const Session session{};
+    return DescriptorBase::ReadSnapshot<ContentionManager, Ts...>(session, addrs...);
   }
 
   /**
-   * @brief Read a value from a given memory address.
-   * \e NOTE: if a memory address is included in MwCAS target fields, it must be read via
-   * this function.
+   * @brief Read the values of multiple targets that coexisted in a given session.
    *
-   * @tparam T an expected class of a target field
-   * @param addr a target memory address to read
-   * @return a read value
+   * @tparam Ts classes of target fields
+   * @param session a session that protects descriptors in the target addresses
+   * @param addrs target memory addresses to read
+   * @return a tuple of read values
    */
-  template <class T>
+  template <class... Ts>
   static auto
-  Read(void *addr)  //
-      -> T
+  ReadSnapshot(  //
+      const Session &session,
+      TargetAddress<Ts>... addrs)  //
+      -> std::tuple<Ts...>
   {
-    [[maybe_unused]] auto &&guard = gc_->CreateEpochGuard();
-    return ReadInternal(addr, nullptr).second.GetTargetData<T>();
+    return DescriptorBase::ReadSnapshot<ContentionManager, Ts...>(session, addrs...);
   }
 
   /**
    * @brief Add a new MwCAS target to this descriptor.
    *
+   * A 16-byte target must be aligned to 16 bytes and uses two entries of this descriptor.
+   * The most significant bit of its first word is reserved to embed a descriptor as well
+   * as 8-byte targets, and the target must not be updated by 8-byte MwCAS operations.
+   *
    * @tparam T a class of a target
    * @param addr a target memory address
    * @param old_val an expected value of a target field
    * @param new_val an inserting value into a target field
    * @retval true if target registration succeeds
-   * @retval false if this descriptor is already full
+   * @retval false if this descriptor is already full or the address is already registered
    */
   template <class T>
-  constexpr auto
+  auto
   AddMwCASTarget(  //
       void *addr,
       const T old_val,
       const T new_val)  //
       -> bool
   {
-    if (target_count_ == kMwCASCapacity) return false;
+    return AddTarget(addr, old_val, new_val, kCapacity);
+  }
 
-    words_[target_count_++] = WordDescriptor{addr, old_val, new_val, this};
-    return true;
+  /**
+   * @brief Add a new compare-only target to this descriptor.
+   *
+   * A MwCAS operation succeeds only if a compare-only target has an expected value, but
+   * it does not install a descriptor into the target and does not write it back. Thus,
+   * read-mostly words (e.g., version counters) can stay in shared cache lines. Since
+   * compare-only targets are validated after installing descriptors into the other
+   * targets, they should be used for words that are not reverted to previous values.
+   *
+   * @tparam T a class of a target
+   * @param addr a target memory address
+   * @param expected an expected value of a target field
+   * @retval true if target registration succeeds
+   * @retval false if this descriptor is already full or the address is already registered
+   */
+  template <class T>
+  auto
+  AddCompareTarget(  //
+      void *addr,
+      const T expected)  //
+      -> bool
+  {
+    return AddTarget(addr, expected, expected, kCapacity, true);
+  }
+
+  /**
+   * @brief Register all the MwCAS targets of this empty descriptor at once.
+   *
+   * The number of targets is checked at compile time, and so this function has no
+   * branches for capacity checks. If target addresses are not distinct, this descriptor
+   * remains empty, and a caller can register other targets or Discard it.
+   *
+   * @tparam Ts classes of targets
+   * @param targets MwCAS targets to be updated
+   * @retval true if the targets are registered.
+   * @retval false if target addresses are not distinct.
+   */
+  template <class... Ts>
+  [[nodiscard]] auto
+  SetMwCASTargets(const MwCASTarget<Ts> &...targets)  //
+      -> bool
+  {
+    static_assert(sizeof...(Ts) > 0);
+    static_assert((component::GetWordNum<Ts>() + ...) <= kCapacity);
+    assert(Size() == 0);
+
+    return SetTargets(targets...);
+  }
+
+  /**
+   * @brief Register a target and its control word with this empty descriptor for RDCSS.
+   *
+   * A MwCAS operation with these targets updates the target only if the control word
+   * has an expected value (i.e., double-compare single-swap). A descriptor is embedded
+   * only into the target, and the control word is validated as a compare-only target.
+   * The target can be read with both the read policies, but a NON_HELPING read finishes
+   * an active RDCSS in the target as a HELPING read does because the operation has been
+   * linearized when its control word is validated. If two RDCSS operations use the
+   * targets of each other as their control words, only one of them can succeed, and
+   * MwCAS retries the other one if it is aborted before its control word changes.
+   *
+   * @tparam C a class of a control word
+   * @tparam T a class of a target
+   * @param control a control word and its expected value
+   * @param target a MwCAS target to be updated
+   * @retval true if the targets are registered.
+   * @retval false if the control word overlaps the target (this descriptor remains empty).
+   */
+  template <class C, class T>
+  [[nodiscard]] auto
+  SetRDCSSTargets(  //
+      const CompareTarget<C> &control,
+      const MwCASTarget<T> &target)  //
+      -> bool
+  {
+    static_assert(component::GetWordNum<C>() + component::GetWordNum<T>() <= kCapacity);
+    assert(Size() == 0);
+
+    return DescriptorBase::SetRDCSSTargets(control, target);
+  }
+
+  /**
+   * @brief Return this descriptor to the pool without performing a MwCAS operation.
+   *
+   * This function is for a descriptor whose targets cannot be registered (e.g., duplicate
+   * addresses). This descriptor must not be used after this function.
+   *
+   */
+  void
+  Discard()
+  {
+    assert(Size() == 0);
+    Recycle();
   }
 
   /**
    * @brief Perform a MwCAS operation by using registered targets.
    *
-   * @retval true if a MwCAS operation succeeds
-   * @retval false if a MwCAS operation fails
+   * Targets are installed in the order of their addresses regardless of the order of
+   * registration (unless MWCAS_AOPT_UNSORTED_TARGETS is defined to measure the effect of
+   * sorting), and then compare-only targets are validated. If a descriptor has only
+   * one target to be updated, this function performs a single-word CAS without embedding
+   * the descriptor. If the sole write target has compare-only targets (i.e., RDCSS), they
+   * are checked before embedding the descriptor into the write target. If pre-validation
+   * is enabled, a MwCAS operation with stale expected values fails without installing
+   * descriptors. If another operation aborts this one because of crossed compare-only
+   * targets, this function retries it with a new descriptor. In any case, this
+   * descriptor must not be used after this function.
+   *
+   * @retval true if a MwCAS operation succeeds.
+   * @retval false otherwise.
    */
   auto
   MwCAS()  //
       -> bool
   {
-    thread_local FinishedDescriptors finished_descriptors{};
-
-    [[maybe_unused]] auto &&guard = gc_->CreateEpochGuard();
+    const auto session = CreateSession();
+    MwCASResult result{};
+    return MwCAS(session, result);
+  }
 
-    // serialize MwCAS operations by embedding a descriptor
-    auto mwcas_success = true;
-    for (size_t i = 0; i < target_count_; ++i) {
-      auto *word_desc = &words_[i];
-    retry_word:
-      auto &&[content, value] = ReadInternal(word_desc->GetAddress(), this);
+  /**
+   * @brief Perform a MwCAS operation and report a mismatched target on failure.
+   *
+   * @param result an output for a mismatched target and its observed value.
+   * @retval true if a MwCAS operation succeeds.
+   * @retval false otherwise.
+   */
+  auto
+  MwCAS(MwCASResult &result)  //
+      -> bool
+  {
+    const auto session = CreateSession();
+    return MwCAS(session, result);
+  }
 
-      if (content.GetTargetData<WordDescriptor *>() == word_desc) {
-        // this word already points to the right place, move on
-        continue;
-      }
+  /**
+   * @brief Perform a MwCAS operation in a given session.
+   *
+   * @param session a session of the domain of this descriptor
+   * @retval true if a MwCAS operation succeeds.
+   * @retval false otherwise.
+   */
+  auto
+  MwCAS(const Session &session)  //
+      -> bool
+  {
+    MwCASResult result{};
+    return MwCAS(session, result);
+  }
 
-      if (value != word_desc->GetOldValue()) {
-        // the expected value is different, the MwCAS fails
-        mwcas_success = false;
-        break;
-      }
+  /**
+   * @brief Perform a MwCAS operation in a given session and report a mismatched target.
+   *
+   * @param session a session of the domain of this descriptor
+   * @param result an output for a mismatched target and its observed value.
+   * @retval true if a MwCAS operation succeeds.
+   * @retval false otherwise.
+   */
+  auto
+  MwCAS(  //
+      [[maybe_unused]] const Session &session,
+      MwCASResult &result)  //
+      -> bool
+  {
+    assert(IsProtectedBy(session));
 
-      if (GetStatus() != Status::ACTIVE) {
-        // this AOPT descriptor has already finished
+    auto *desc = this;
+    while (true) {
+      result = MwCASResult{};
+      if (!desc->Execute(result)) {
+        // other threads have never observed this descriptor
+        desc->Recycle();
         break;
       }
+      if (result || !desc->IsAborted(result)) break;
 
-      // try to install the pointer to my descriptor
-      if (!word_desc->EmbedDescriptor(content)) {
-        // if failed, retry
-        goto retry_word;  // NOLINT
-      }
+      // the descriptor lost a conflict on compare-only targets, so retry with a new one
+      component::Statistics::Add(GetDomainID(), component::OPERATION_RETRY);
+      auto *next = GetDescriptor(GetDomainID());
+      next->CopyTargets(*desc);
+      desc = next;
     }
+    return static_cast<bool>(result);
+  }
 
-    // update status of this descriptor
-    auto expected = Status::ACTIVE;
-    const auto desired = (mwcas_success) ? Status::SUCCESSFUL : Status::FAILED;
-    const auto success =
-        status_.compare_exchange_strong(expected, desired, std::memory_order_relaxed);
-
-    if (success) {
-      // if this thread finalized the descriptor, mark it for reclamation
-      finished_descriptors.RetireForCleanUp(this);
-    }
+  /**
+   * @brief Update multiple targets by using their current values until success.
+   *
+   * This function reads the current values of targets, computes new values by a given
+   * function, and performs a MwCAS operation with them. If the MwCAS operation fails, this
+   * function retries it with the latest values. When a failed attempt has never published
+   * its descriptor (e.g., pre-validation or a single-word CAS fails), the descriptor is
+   * reused for the next attempt, and so a call allocates one descriptor unless attempts
+   * fail after embedding descriptors. For example, `MwCASUpdate<uint64_t>(addrs, inc)`
+   * increments the counters in `std::array<void *, 2> addrs` if `inc` returns incremented
+   * values.
+   *
+   * @tparam T a class of targets
+   * @tparam kN the number of targets
+   * @tparam Fn a class of a function to compute new values
+   * @param addrs target memory addresses (must be distinct)
+   * @param fn a function that receives `const std::array<T, kN> &` of current values and
+   * returns `std::array<T, kN>` of new values. It may be called multiple times, and so
+   * it must not have side effects.
+   * @return the values of targets just before the successful MwCAS operation.
+   */
+  template <class T, size_t kN, class Fn>
+  static auto
+  MwCASUpdate(  //
+      const std::array<void *, kN> &addrs,
+      Fn &&fn)  //
+      -> std::array<T, kN>
+  {
+    const Session session{};
+    return UpdateInternal<T>(component::kDefaultDomainID, session, addrs, fn);
+  }
 
-    return GetStatus() == Status::SUCCESSFUL;
+  /**
+   * @brief Update multiple targets by using their current values in a given session.
+   *
+   * @tparam T a class of targets
+   * @tparam kN the number of targets
+   * @tparam Fn a class of a function to compute new values
+   * @param session a session of the default domain
+   * @param addrs target memory addresses (must be distinct)
+   * @param fn a function to compute new values from current ones
+   * @return the values of targets just before the successful MwCAS operation.
+   */
+  template <class T, size_t kN, class Fn>
+  static auto
+  MwCASUpdate(  //
+      const Session &session,
+      const std::array<void *, kN> &addrs,
+      Fn &&fn)  //
+      -> std::array<T, kN>
+  {
+    return UpdateInternal<T>(component::kDefaultDomainID, session, addrs, fn);
   }
 
  private:
+  friend class MwCASDomain;
+
   /*################################################################################################
-   * Internal classes
+   * Internal constructors
    *##############################################################################################*/
 
   /**
-   * @brief A class to manage finished AOPT descriptors.
+   * @brief Construct an empty descriptor for MwCAS operations.
+   *
+   * A descriptor must be constructed in a page of a descriptor pool (i.e., only via
+   * GetDescriptor) because the page is aligned to its size.
    *
+   * @param domain_id the ID of a domain that this descriptor belongs to.
    */
-  class FinishedDescriptors
+  explicit AOPTDescriptor(const size_t domain_id)
+      : DescriptorBase{domain_id}
   {
-   public:
-    /*##############################################################################################
-     * Public constructors and assignment operators
-     *############################################################################################*/
-
-    /**
-     * @brief Create a new FinishedDescriptors object.
-     *
-     */
-    constexpr FinishedDescriptors() = default;
-
-    FinishedDescriptors(const FinishedDescriptors &) = delete;
-    FinishedDescriptors &operator=(const FinishedDescriptors &obj) = delete;
-    FinishedDescriptors(FinishedDescriptors &&) = delete;
-    FinishedDescriptors &operator=(FinishedDescriptors &&) = delete;
-
-    /*##############################################################################################
-     * Public destructors
-     *############################################################################################*/
-
-    /**
-     * @brief Destroy the FinishedDescriptors object.
-     *
-     */
-    ~FinishedDescriptors()
-    {
-      [[maybe_unused]] auto &&guard = gc_->CreateEpochGuard();
-      FinalizeFinishedDescriptors();
-    }
+    // GetParent derives this descriptor from the addresses of its word descriptors
+    assert(reinterpret_cast<uintptr_t>(this) % component::kDescriptorPageSize == 0);  // NOLINT
+    assert(static_cast<void *>(words_) == GetWords());
+  }
 
-    /*##############################################################################################
-     * Public utility functions
-     *############################################################################################*/
-
-    /**
-     * @brief Register a finished descriptor with the internal list.
-     *
-     * If the number of finished descriptors reaches a certain threshold, this function
-     * invoke finalization of finished descriptors to release them.
-     *
-     * @param desc a finished descriptor.
-     */
-    void
-    RetireForCleanUp(AOPTDescriptor *desc)
-    {
-      if (desc_num_ >= kMaxFinishedDescriptors) {
-        FinalizeFinishedDescriptors();
-      }
-      desc_arr_[desc_num_++] = desc;
-    }
+  /*################################################################################################
+   * Internal utility functions
+   *##############################################################################################*/
 
-   private:
-    /*##############################################################################################
-     * Internal utility functions
-     *############################################################################################*/
-
-    /**
-     * @brief Perform finalization for AOPT-based MwCAS.
-     *
-     * After this function, finished descriptors become targets of internal GC.
-     */
-    void
-    FinalizeFinishedDescriptors()
-    {
-      for (size_t i = 0; i < desc_num_; ++i) {
-        auto *desc = desc_arr_[i];
-        const auto status = desc->GetStatus();
-        const auto word_num = desc->Size();
-        for (size_t i = 0; i < word_num; ++i) {
-          desc->words_[i].CompleteMwCAS(status);
-        }
-        gc_->AddGarbage(desc);
+  /**
+   * @brief Perform a MwCAS operation by using registered targets without recycling.
+   *
+   * @param result an output for the details of this operation.
+   * @retval true if this descriptor has been published and so must be reclaimed by GC
+   * @retval false if other threads have never observed this descriptor
+   */
+  auto
+  Execute(MwCASResult &result)  //
+      -> bool
+  {
+    auto published = false;
+    if (Size() == 1 && GetWriteCount() == 1) {
+      SingleWordCAS<ContentionManager>(result);
+    } else if (GetWriteCount() == 1) {
+      published = RDCSSInternal<ContentionManager>(result);
+    } else {
+      if constexpr (kSortTargets) {
+        SortWords<kCapacity>();
+      }
+      if (PreValidate(result)) {
+        published = MwCASInternal<ContentionManager>(&result);
       }
-
-      desc_num_ = 0;
     }
 
-    /*##############################################################################################
-     * Internal member variables
-     *############################################################################################*/
-
-    /// pointers to finished descriptors
-    std::array<AOPTDescriptor *, kMaxFinishedDescriptors> desc_arr_{};
-
-    /// the current number of finished descriptors
-    size_t desc_num_{0};
-  };
+    const auto counter = (result) ? component::MWCAS_SUCCESS : component::MWCAS_FAILURE;
+    component::Statistics::Add(GetDomainID(), counter);
+    return published;
+  }
 
-  /*################################################################################################
-   * Internal utility functions
-   *##############################################################################################*/
+  /**
+   * @brief Check whether this published descriptor failed without any mismatched target.
+   *
+   * When descriptors with compare-only targets conflict with each other, the one with the
+   * higher address fails (see DescriptorBase::ValidateCompareTargets). In this case, every
+   * target still has its expected value, and so the operation must be retried.
+   *
+   * @param result the details of a failed operation by using this descriptor.
+   * @retval true if this descriptor has been aborted by a conflict.
+   * @retval false otherwise.
+   */
+  [[nodiscard]] auto
+  IsAborted(const MwCASResult &result) const  //
+      -> bool
+  {
+    return result.GetFailedAddress() == nullptr && GetWriteCount() != Size();
+  }
 
   /**
-   * @brief Read a value from a given memory address.
-   * \e NOTE: if a memory address is included in MwCAS target fields, it must be read via
-   * this function.
+   * @brief Update multiple targets by using their current values in a given domain.
    *
-   * @tparam T an expected class of a target field
-   * @param addr a target memory address to read
-   * @return a read value
+   * @tparam T a class of targets
+   * @tparam kN the number of targets
+   * @tparam Fn a class of a function to compute new values
+   * @param domain_id the ID of a domain that descriptors belong to
+   * @param session a session of the domain
+   * @param addrs target memory addresses (must be distinct)
+   * @param fn a function to compute new values from current ones
+   * @return the values of targets just before the successful MwCAS operation.
    */
+  template <class T, size_t kN, class Fn>
   static auto
-  ReadInternal(  //
-      void *addr,
-      AOPTDescriptor *self)  //
-      -> std::pair<MwCASField, MwCASField>
+  UpdateInternal(  //
+      const size_t domain_id,
+      const Session &session,
+      const std::array<void *, kN> &addrs,
+      Fn &&fn)  //
+      -> std::array<T, kN>
   {
-    auto *target_addr = static_cast<std::atomic<MwCASField> *>(addr);
+    static_assert(kN > 0);
+    static_assert(kN * component::GetWordNum<T>() <= kCapacity);
+
+    auto *desc = GetDescriptor(domain_id);
+    assert(desc->IsProtectedBy(session));
 
-    MwCASField target_word;
-    MwCASField act_val;
+    ContentionManager cm{};
     while (true) {
-      target_word = target_addr->load(std::memory_order_acquire);
-      if (!target_word.IsWordDescriptor()) {
-        act_val = target_word;
-        break;
+      std::array<T, kN> old_vals{};
+      for (size_t i = 0; i < kN; ++i) {
+        old_vals[i] = Read<T>(addrs[i], session);
+      }
+      const std::array<T, kN> new_vals = fn(std::as_const(old_vals));
+      for (size_t i = 0; i < kN; ++i) {
+        [[maybe_unused]] const auto added =
+            desc->AddMwCASTarget(addrs[i], old_vals[i], new_vals[i]);
+        assert(added);
       }
 
-      // found a word descriptor
-      auto *word = target_word.GetTargetData<WordDescriptor *>();
-      auto *parent = static_cast<AOPTDescriptor *>(word->GetParent());
-      const auto parent_status = parent->GetStatus();
-      if (parent != self && parent_status == Status::ACTIVE) {
-        parent->MwCAS();
-        continue;
+      MwCASResult result{};
+      const auto published = desc->Execute(result);
+      if (result) {
+        if (!published) desc->Recycle();
+        return old_vals;
       }
-      act_val = word->GetCurrentValue(parent_status);
-      break;
+
+      // an unpublished descriptor can be reused without waiting for GC
+      component::Statistics::Add(domain_id, component::OPERATION_RETRY);
+      desc = published ? GetDescriptor(domain_id) : new (desc) AOPTDescriptor{domain_id};
+      cm.OnEmbedFailure();
     }
+  }
+
+  /**
+   * @param domain_id the ID of a domain that a new descriptor belongs to.
+   * @return a new MwCAS descriptor in a given domain.
+   */
+  static auto
+  GetDescriptor(const size_t domain_id)  //
+      -> AOPTDescriptor *
+  {
+    // a page must be aligned to its size to derive descriptors from word descriptors
+    static_assert(alignof(component::DescriptorPage) >= component::kDescriptorPageSize);
+
+    // each descriptor must be reclaimed as a memory page without any destructor
+    static_assert(kCapacity > 0 && kCapacity <= kMwCASCapacity);
+    static_assert(sizeof(AOPTDescriptor) <= sizeof(component::DescriptorPage));
+    static_assert(std::is_trivially_destructible_v<AOPTDescriptor>);
 
-    return {target_word, act_val};
+    return new (GetPage(domain_id)) AOPTDescriptor{domain_id};
   }
 
   /*################################################################################################
    * Internal member variables
    *##############################################################################################*/
 
-  /// a garbage collector for expired descriptors
-  inline static std::unique_ptr<EpochBasedGC_t> gc_{nullptr};  // NOLINT
+  /// Target entries of MwCAS (constructed when targets are added)
+  alignas(WordDescriptor) std::byte words_[kCapacity * sizeof(WordDescriptor)];  // NOLINT
+};
 
-  /// a status of this AOPT descriptor
-  std::atomic<Status> status_{Status::ACTIVE};
+/*##################################################################################################
+ * Global utility functions
+ *################################################################################################*/
 
-  /// The number of registered MwCAS targets
-  size_t target_count_{0};
+/**
+ * @brief Perform a MwCAS operation on targets known at compile time.
+ *
+ * This function uses a descriptor whose capacity is exactly the number of target words,
+ * and so the capacity is checked statically and the targets are sorted by a sorting
+ * network unrolled for the number. For example, a two-word operation can be written as
+ * `MwCAS(MwCASTarget{addr_1, old_1, new_1}, MwCASTarget{addr_2, old_2, new_2})`.
+ *
+ * @tparam ContentionManager a class to decide when to help active MwCAS operations
+ * @tparam Ts classes of targets
+ * @param targets MwCAS targets with distinct addresses
+ * @retval true if a MwCAS operation succeeds.
+ * @retval false otherwise (including duplicate target addresses).
+ */
+template <class ContentionManager = EagerHelping, class... Ts>
+auto
+MwCAS(const MwCASTarget<Ts> &...targets)  //
+    -> bool
+{
+  constexpr auto kWordNum = (component::GetWordNum<Ts>() + ...);
+  auto *desc = AOPTDescriptor<kWordNum, ContentionManager>::GetDescriptor();
+  if (!desc->SetMwCASTargets(targets...)) {
+    desc->Discard();
+    return false;
+  }
+  return desc->MwCAS();
+}
 
-  /// Target entries of MwCAS
-  WordDescriptor words_[kMwCASCapacity];
-};
+/**
+ * @brief Perform a MwCAS operation on targets known at compile time in a given session.
+ *
+ * @tparam ContentionManager a class to decide when to help active MwCAS operations
+ * @tparam Ts classes of targets
+ * @param session a session of the default domain
+ * @param targets MwCAS targets with distinct addresses
+ * @retval true if a MwCAS operation succeeds.
+ * @retval false otherwise (including duplicate target addresses).
+ */
+template <class ContentionManager = EagerHelping, class... Ts>
+auto
+MwCAS(  //
+    const component::DescriptorBase::Session &session,
+    const MwCASTarget<Ts> &...targets)  //
+    -> bool
+{
+  constexpr auto kWordNum = (component::GetWordNum<Ts>() + ...);
+  auto *desc = AOPTDescriptor<kWordNum, ContentionManager>::GetDescriptor();
+  if (!desc->SetMwCASTargets(targets...)) {
+    desc->Discard();
+    return false;
+  }
+  return desc->MwCAS(session);
+}
+
+/**
+ * @brief Perform a MwCAS operation on targets in a given session and report a mismatch.
+ *
+ * @tparam ContentionManager a class to decide when to help active MwCAS operations
+ * @tparam Ts classes of targets
+ * @param session a session of the default domain
+ * @param result an output for a mismatched target and its observed value.
+ * @param targets MwCAS targets with distinct addresses
+ * @retval true if a MwCAS operation succeeds.
+ * @retval false otherwise (including duplicate target addresses).
+ */
+template <class ContentionManager = EagerHelping, class... Ts>
+auto
+MwCAS(  //
+    const component::DescriptorBase::Session &session,
+    component::MwCASResult &result,
+    const MwCASTarget<Ts> &...targets)  //
+    -> bool
+{
+  constexpr auto kWordNum = (component::GetWordNum<Ts>() + ...);
+  auto *desc = AOPTDescriptor<kWordNum, ContentionManager>::GetDescriptor();
+  if (!desc->SetMwCASTargets(targets...)) {
+    desc->Discard();
+    result = component::MwCASResult{nullptr, component::MwCASField{}};
+    return false;
+  }
+  return desc->MwCAS(session, result);
+}
+
+/**
+ * @brief Update a target only if a control word has an expected value (i.e., RDCSS).
+ *
+ * This function is cheaper than a two-word MwCAS that writes the same value back to the
+ * control word because a descriptor is embedded only into the target. If the control
+ * word has already been changed, this function fails without writing any word. For
+ * example, `RDCSS(CompareTarget{&version, ver}, MwCASTarget{&slot, old_val, new_val})`.
+ * The target may be read with ReadPolicy::NON_HELPING, but such reads finish an active
+ * RDCSS in the target instead of returning its expected value (see SetRDCSSTargets).
+ *
+ * @tparam ContentionManager a class to decide when to help active MwCAS operations
+ * @tparam C a class of a control word
+ * @tparam T a class of a target
+ * @param control a control word and its expected value
+ * @param target a MwCAS target to be updated (its address must differ from the control)
+ * @retval true if an RDCSS operation succeeds.
+ * @retval false otherwise (including a target that overlaps the control word).
+ */
+template <class ContentionManager = EagerHelping, class C, class T>
+auto
+RDCSS(  //
+    const CompareTarget<C> &control,
+    const MwCASTarget<T> &target)  //
+    -> bool
+{
+  constexpr auto kWordNum = component::GetWordNum<C>() + component::GetWordNum<T>();
+  auto *desc = AOPTDescriptor<kWordNum, ContentionManager>::GetDescriptor();
+  if (!desc->SetRDCSSTargets(control, target)) {
+    desc->Discard();
+    return false;
+  }
+  return desc->MwCAS();
+}
+
+/**
+ * @brief Update a target only if a control word has an expected value in a given session.
+ *
+ * @tparam ContentionManager a class to decide when to help active MwCAS operations
+ * @tparam C a class of a control word
+ * @tparam T a class of a target
+ * @param session a session of the default domain
+ * @param control a control word and its expected value
+ * @param target a MwCAS target to be updated (its address must differ from the control)
+ * @retval true if an RDCSS operation succeeds.
+ * @retval false otherwise (including a target that overlaps the control word).
+ */
+template <class ContentionManager = EagerHelping, class C, class T>
+auto
+RDCSS(  //
+    const component::DescriptorBase::Session &session,
+    const CompareTarget<C> &control,
+    const MwCASTarget<T> &target)  //
+    -> bool
+{
+  constexpr auto kWordNum = component::GetWordNum<C>() + component::GetWordNum<T>();
+  auto *desc = AOPTDescriptor<kWordNum, ContentionManager>::GetDescriptor();
+  if (!desc->SetRDCSSTargets(control, target)) {
+    desc->Discard();
+    return false;
+  }
+  return desc->MwCAS(session);
+}
+
+/**
+ * @brief Update a target only if a control word has an expected value and report a
+ * mismatched word on failure.
+ *
+ * @tparam ContentionManager a class to decide when to help active MwCAS operations
+ * @tparam C a class of a control word
+ * @tparam T a class of a target
+ * @param session a session of the default domain
+ * @param result an output for a mismatched word and its observed value.
+ * @param control a control word and its expected value
+ * @param target a MwCAS target to be updated (its address must differ from the control)
+ * @retval true if an RDCSS operation succeeds.
+ * @retval false otherwise (including a target that overlaps the control word).
+ */
+template <class ContentionManager = EagerHelping, class C, class T>
+auto
+RDCSS(  //
+    const component::DescriptorBase::Session &session,
+    component::MwCASResult &result,
+    const CompareTarget<C> &control,
+    const MwCASTarget<T> &target)  //
+    -> bool
+{
+  constexpr auto kWordNum = component::GetWordNum<C>() + component::GetWordNum<T>();
+  auto *desc = AOPTDescriptor<kWordNum, ContentionManager>::GetDescriptor();
+  if (!desc->SetRDCSSTargets(control, target)) {
+    desc->Discard();
+    result = component::MwCASResult{nullptr, component::MwCASField{}};
+    return false;
+  }
+  return desc->MwCAS(session, result);
+}
+
+/**
+ * @brief Update multiple targets by using their current values until success.
+ *
+ * This function uses a descriptor whose capacity is exactly the number of target words
+ * and reuses it across failed attempts that have never published it (see
+ * AOPTDescriptor::MwCASUpdate). For example, `MwCASUpdate<uint64_t>(addrs, [](const auto
+ * &v) { return std::array<uint64_t, 2>{v[0] - 1, v[1] + 1}; })` moves one from a counter
+ * to another.
+ *
+ * @tparam T a class of targets
+ * @tparam ContentionManager a class to decide when to help active MwCAS operations
+ * @tparam kN the number of targets
+ * @tparam Fn a class of a function to compute new values
+ * @param addrs target memory addresses (must be distinct)
+ * @param fn a function to compute new values from current ones without side effects
+ * @return the values of targets just before the successful MwCAS operation.
+ */
+template <class T, class ContentionManager = EagerHelping, size_t kN, class Fn>
+auto
+MwCASUpdate(  //
+    const std::array<void *, kN> &addrs,
+    Fn &&fn)  //
+    -> std::array<T, kN>
+{
+  constexpr auto kWordNum = kN * component::GetWordNum<T>();
+  return AOPTDescriptor<kWordNum, ContentionManager>::template MwCASUpdate<T>(addrs, fn);
+}
+
+/**
+ * @brief Update multiple targets by using their current values in a given session.
+ *
+ * @tparam T a class of targets
+ * @tparam ContentionManager a class to decide when to help active MwCAS operations
+ * @tparam kN the number of targets
+ * @tparam Fn a class of a function to compute new values
+ * @param session a session of the default domain
+ * @param addrs target memory addresses (must be distinct)
+ * @param fn a function to compute new values from current ones without side effects
+ * @return the values of targets just before the successful MwCAS operation.
+ */
+template <class T, class ContentionManager = EagerHelping, size_t kN, class Fn>
+auto
+MwCASUpdate(  //
+    const component::DescriptorBase::Session &session,
+    const std::array<void *, kN> &addrs,
+    Fn &&fn)  //
+    -> std::array<T, kN>
+{
+  constexpr auto kWordNum = kN * component::GetWordNum<T>();
+  return AOPTDescriptor<kWordNum, ContentionManager>::template MwCASUpdate<T>(session, addrs, fn);
+}
 
 }  // namespace dbgroup::atomic::aopt
 
@@ -0,0 +1,272 @@
+/*
+ * Copyright 2021 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MWCAS_AOPT_AOPT_AOPT_RANGE_DESCRIPTOR_H_
+#define MWCAS_AOPT_AOPT_AOPT_RANGE_DESCRIPTOR_H_
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+#include "component/descriptor_base.hpp"
+#include "contention_manager.hpp"
+
+namespace dbgroup::atomic::aopt
+{
+class MwCASDomain;
+
+/**
+ * @brief A class to manage a MwCAS operation on a range of contiguous words by using
+ * AOPT algorithm.
+ *
+ * A range descriptor retains only the base address of targets and a pair of old/new
+ * values for each word, and so each word uses 16 bytes instead of 24 bytes of a word
+ * descriptor. If a range does not fit in a descriptor page, its words are placed in
+ * extension pages taken from the same pool, and so the length of a range is bounded by
+ * kCapacity rather than kMwCASCapacity. Since targets are installed and
+ * completed from the lowest address, the next cache line of targets is prefetched while
+ * the current one is updated.
+ *
+ * Range and normal descriptors share GC and the helping procedure, and so they can
+ * update the same words. Target words must be read via Read functions of AOPTDescriptor
+ * or DescriptorBase as with normal MwCAS targets.
+ *
+ * @tparam ContentionManager a class to decide when to help active MwCAS operations and
+ * how to wait for retries (e.g., EagerHelping, ExponentialBackoff, and RandomizedHelping).
+ */
+template <class ContentionManager = EagerHelping>
+class alignas(component::kCacheLineSize) AOPTRangeDescriptor : public component::DescriptorBase
+{
+  using RangeWordDescriptor = component::RangeWordDescriptor;
+
+  /// the size of word descriptors in a page (or pointers to extension pages instead)
+  static constexpr size_t kWordsSize = component::kRangeWordsPerPage * sizeof(RangeWordDescriptor);
+
+ public:
+  /*################################################################################################
+   * Public constants
+   *##############################################################################################*/
+
+  /// the maximum number of target words of this descriptor
+  static constexpr size_t kCapacity = component::kMaxRangeLength;
+
+  /*################################################################################################
+   * Public constructors and assignment operators
+   *##############################################################################################*/
+
+  AOPTRangeDescriptor(const AOPTRangeDescriptor &) = delete;
+  AOPTRangeDescriptor &operator=(const AOPTRangeDescriptor &obj) = delete;
+  AOPTRangeDescriptor(AOPTRangeDescriptor &&) = delete;
+  AOPTRangeDescriptor &operator=(AOPTRangeDescriptor &&) = delete;
+
+  /*################################################################################################
+   * Public destructors
+   *##############################################################################################*/
+
+  /**
+   * @brief Destroy the AOPTRangeDescriptor object.
+   *
+   */
+  ~AOPTRangeDescriptor() = default;
+
+  /*################################################################################################
+   * Public utility functions
+   *##############################################################################################*/
+
+  /**
+   * @return Get a new range descriptor for the AOPT algorithm in the default domain.
+   */
+  static auto
+  GetDescriptor()  //
+      -> AOPTRangeDescriptor *
+  {
+    return GetDescriptor(component::kDefaultDomainID);
+  }
+
+  /**
+   * @brief Register contiguous target words with this empty descriptor.
+   *
+   * For example, shifting `n` slots of a sorted array to the right can be written as
+   * `desc->SetMwCASRange(&slots[0], &cur[0], &cur_shifted[0], n + 1)`.
+   *
+   * @tparam T a class of targets (the size must be the same as a word)
+   * @param addr the address of the first target word (aligned to words)
+   * @param old_vals expected values of the target words
+   * @param new_vals inserting values into the target words
+   * @param n the number of target words
+   * @retval true if the targets are registered
+   * @retval false if the range is empty or longer than kCapacity
+   */
+  template <class T>
+  auto
+  SetMwCASRange(  //
+      void *addr,
+      const T *old_vals,
+      const T *new_vals,
+      const size_t n)  //
+      -> bool
+  {
+    static_assert(sizeof(T) == component::kWordSize);
+    static_assert(CanMwCAS<T>());
+    assert(Size() == 0);
+
+    if (n == 0 || n > kCapacity) return false;
+    SetRangeTargets(addr, old_vals, new_vals, n);
+    return true;
+  }
+
+  /**
+   * @brief Perform a MwCAS operation on the registered range.
+   *
+   * If pre-validation is enabled, a MwCAS operation with stale expected values fails
+   * without installing descriptors. In any case, this descriptor must not be used after
+   * this function.
+   *
+   * @retval true if a MwCAS operation succeeds.
+   * @retval false otherwise.
+   */
+  auto
+  MwCAS()  //
+      -> bool
+  {
+    const auto session = CreateSession();
+    MwCASResult result{};
+    return MwCAS(session, result);
+  }
+
+  /**
+   * @brief Perform a MwCAS operation on the registered range and report a mismatched word.
+   *
+   * @param result an output for a mismatched word and its observed value.
+   * @retval true if a MwCAS operation succeeds.
+   * @retval false otherwise.
+   */
+  auto
+  MwCAS(MwCASResult &result)  //
+      -> bool
+  {
+    const auto session = CreateSession();
+    return MwCAS(session, result);
+  }
+
+  /**
+   * @brief Perform a MwCAS operation on the registered range in a given session.
+   *
+   * @param session a session of the domain of this descriptor
+   * @retval true if a MwCAS operation succeeds.
+   * @retval false otherwise.
+   */
+  auto
+  MwCAS(const Session &session)  //
+      -> bool
+  {
+    MwCASResult result{};
+    return MwCAS(session, result);
+  }
+
+  /**
+   * @brief Perform a MwCAS operation on the registered range in a given session and
+   * report a mismatched word.
+   *
+   * @param session a session of the domain of this descriptor
+   * @param result an output for a mismatched word and its observed value.
+   * @retval true if a MwCAS operation succeeds.
+   * @retval false otherwise.
+   */
+  auto
+  MwCAS(  //
+      [[maybe_unused]] const Session &session,
+      MwCASResult &result)  //
+      -> bool
+  {
+    assert(IsProtectedBy(session));
+    assert(Size() > 0);
+
+    // the targets of a range are already sorted by their addresses
+    result = MwCASResult{};
+    if (!PreValidate(result) || !MwCASInternal<ContentionManager>(&result)) {
+      // other threads have never observed this descriptor
+      Recycle();
+    }
+
+    const auto counter = (result) ? component::MWCAS_SUCCESS : component::MWCAS_FAILURE;
+    component::Statistics::Add(GetDomainID(), counter);
+    return static_cast<bool>(result);
+  }
+
+ private:
+  friend class MwCASDomain;
+
+  /*################################################################################################
+   * Internal constructors
+   *##############################################################################################*/
+
+  /**
+   * @brief Construct an empty descriptor for MwCAS operations on a range.
+   *
+   * A descriptor must be constructed in a page of a descriptor pool (i.e., only via
+   * GetDescriptor) because the page is aligned to its size.
+   *
+   * @param domain_id the ID of a domain that this descriptor belongs to.
+   */
+  explicit AOPTRangeDescriptor(const size_t domain_id)
+      : DescriptorBase{domain_id, component::Layout::RANGE}
+  {
+    // GetParent derives this descriptor from the addresses of its word descriptors
+    assert(reinterpret_cast<uintptr_t>(this) % component::kDescriptorPageSize == 0);  // NOLINT
+    assert(static_cast<void *>(words_) == GetRangeWords());
+    assert(static_cast<void *>(&base_) ==
+           reinterpret_cast<std::byte *>(this) + component::kDescriptorHeaderSize);  // NOLINT
+  }
+
+  /*################################################################################################
+   * Internal utility functions
+   *##############################################################################################*/
+
+  /**
+   * @param domain_id the ID of a domain that a new descriptor belongs to.
+   * @return a new range descriptor in a given domain.
+   */
+  static auto
+  GetDescriptor(const size_t domain_id)  //
+      -> AOPTRangeDescriptor *
+  {
+    // a page must be aligned to its size to derive descriptors from word descriptors
+    static_assert(alignof(component::DescriptorPage) >= component::kDescriptorPageSize);
+
+    // each descriptor must be reclaimed as a memory page without any destructor
+    static_assert(sizeof(AOPTRangeDescriptor) <= sizeof(component::DescriptorPage));
+    static_assert(std::is_trivially_destructible_v<AOPTRangeDescriptor>);
+
+    return new (GetPage(domain_id)) AOPTRangeDescriptor{domain_id};
+  }
+
+  /*################################################################################################
+   * Internal member variables
+   *##############################################################################################*/
+
+  /// the address of the first target word
+  void *base_{nullptr};
+
+  /// Target entries of MwCAS or pointers to extension pages for a long range
+  alignas(RangeWordDescriptor) std::byte words_[kWordsSize];  // NOLINT
+};
+
+}  // namespace dbgroup::atomic::aopt
+
+#endif  // MWCAS_AOPT_AOPT_AOPT_RANGE_DESCRIPTOR_H_
@@ -35,7 +35,7 @@ constexpr size_t kCacheLineSize = 64;
  * @brief An enumeration for representing AOPT status
  *
  */
-enum Status : uint64_t
+enum Status : uint8_t
 {
   SUCCESSFUL = 0,
   ACTIVE,
@@ -0,0 +1,2210 @@
+/*
+ * Copyright 2021 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MWCAS_AOPT_AOPT_COMPONENT_DESCRIPTOR_BASE_H_
+#define MWCAS_AOPT_AOPT_COMPONENT_DESCRIPTOR_BASE_H_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../contention_manager.hpp"
+#include "descriptor_pool.hpp"
+#include "memory/epoch_based_gc.hpp"
+#include "mwcas_result.hpp"
+#include "simd_utility.hpp"
+#include "statistics.hpp"
+#include "word_descriptor.hpp"
+
+namespace dbgroup::atomic::aopt
+{
+class MwCASDomain;
+}  // namespace dbgroup::atomic::aopt
+
+namespace dbgroup::atomic::aopt::component
+{
+/*##################################################################################################
+ * Global constants and structs
+ *################################################################################################*/
+
+/// The size of a descriptor header (i.e., a status, a layout, a domain, and target counts).
+constexpr size_t kDescriptorHeaderSize = kWordSize;
+
+/// The offset of word descriptors in a range descriptor (i.e., after its base address).
+constexpr size_t kRangeWordsOffset = kDescriptorHeaderSize + kWordSize;
+
+/**
+ * @brief An enumeration for representing the layout of a descriptor page.
+ *
+ */
+enum Layout : uint8_t
+{
+  WORDS = 0,
+  RANGE,
+  RANGE_EXTENSION
+};
+
+/// The ID of the default domain, which is used by static functions of descriptors.
+constexpr size_t kDefaultDomainID = 0;
+
+/**
+ * @return the minimum power of two (at least a cache line) to contain the largest
+ * descriptor.
+ */
+constexpr auto
+GetDescriptorPageSize()  //
+    -> size_t
+{
+  size_t size = kCacheLineSize;
+  while (size < kDescriptorHeaderSize + kMwCASCapacity * sizeof(WordDescriptor)) {
+    size *= 2;
+  }
+  return size;
+}
+
+/// The size and alignment of memory pages for descriptors.
+constexpr size_t kDescriptorPageSize = GetDescriptorPageSize();
+
+/// The number of word descriptors of a range in one page.
+constexpr size_t kRangeWordsPerPage =
+    (kDescriptorPageSize - kRangeWordsOffset) / sizeof(RangeWordDescriptor);
+
+/// The maximum number of extension pages that a range descriptor refers to.
+constexpr size_t kMaxRangePageNum = (kDescriptorPageSize - kRangeWordsOffset) / kWordSize;
+
+/// The maximum number of contiguous target words of a range descriptor.
+constexpr size_t kMaxRangeLength = std::min<size_t>(kRangeWordsPerPage * kMaxRangePageNum,
+                                                    std::numeric_limits<uint16_t>::max());
+
+/**
+ * @brief A memory page to contain a descriptor of any capacity.
+ *
+ * Descriptors of different capacities are reclaimed by the same GC so that they share
+ * one epoch. Thus, GC and descriptor pools deal with fixed-size pages instead of
+ * each descriptor class. Since each page is aligned to its size, the parent descriptor
+ * of a word descriptor is derived by masking the address of the word descriptor.
+ *
+ * Pages are allocated by descriptor pools on the NUMA nodes of their users, and so GC
+ * releases them via the class-specific operators below.
+ *
+ */
+struct alignas(kDescriptorPageSize) DescriptorPage {
+  static auto
+  operator new(  //
+      [[maybe_unused]] const size_t size,
+      [[maybe_unused]] const std::align_val_t align)  //
+      -> void *
+  {
+    assert(size == sizeof(DescriptorPage) && align == std::align_val_t{alignof(DescriptorPage)});
+    return AllocateOnNode<sizeof(DescriptorPage)>();
+  }
+
+  static void
+  operator delete(  //
+      void *page,
+      [[maybe_unused]] const std::align_val_t align)
+  {
+    FreeOnNode<sizeof(DescriptorPage)>(page);
+  }
+
+  /// a memory space for a descriptor
+  std::byte data[kDescriptorPageSize];
+};
+
+/**
+ * @brief A class to perform the capacity-independent parts of AOPT-based MwCAS.
+ *
+ * Each AOPT descriptor consists of this header and a following array of word
+ * descriptors, and so threads can help any other descriptor regardless of its capacity.
+ *
+ * A range descriptor instead has a base address and an array of compact word descriptors
+ * for contiguous target words, and the layout in its header tells helpers which one it has.
+ * If the words of a range do not fit in one page, the range descriptor retains pointers to
+ * extension pages instead, each of which has a header, a pointer to the range descriptor,
+ * and a part of the words. Since extension pages are taken from the same pool and retired
+ * together with their range descriptor, the length of a range is not bounded by a page.
+ *
+ * Each descriptor belongs to a MwCAS domain, which has its own GC, per-thread pools,
+ * finished descriptors, and statistics. A header retains the ID of its domain, and so
+ * descriptors are recycled and retired into their own domains. Static functions (e.g.,
+ * StartGC and GetDescriptor) use the default domain.
+ *
+ */
+class DescriptorBase
+{
+  using EpochBasedGC_t = ::dbgroup::memory::EpochBasedGC<DescriptorPage>;
+  using DescriptorPool_t = DescriptorPool<DescriptorPage>;
+
+  template <class T>
+  using TargetField_t = std::conditional_t<sizeof(T) == kWideWordSize, WideField, MwCASField>;
+
+ public:
+  /*################################################################################################
+   * Public type aliases
+   *##############################################################################################*/
+
+  using PoolStatistics = component::PoolStatistics;
+  using MwCASStatistics = component::MwCASStatistics;
+  using MwCASResult = component::MwCASResult;
+
+  /// the class of the address of a target (used to pair addresses with their classes)
+  template <class T>
+  using TargetAddress = void *;
+
+  /*################################################################################################
+   * Public classes
+   *##############################################################################################*/
+
+  /**
+   * @brief A class to hold an epoch guard across a sequence of operations.
+   *
+   * Each Read/MwCAS call without a session enters and leaves an epoch. By passing a
+   * session to them, a read-modify-MwCAS sequence enters an epoch only once. A session
+   * must be used in the thread that creates it and destroyed before stopping GC. Note
+   * that a long-lived session delays the reclamation of descriptors.
+   *
+   */
+  class Session
+  {
+   public:
+    /**
+     * @brief Enter an epoch of the default domain for a new session.
+     *
+     */
+    Session() : Session{kDefaultDomainID} {}
+
+    Session(const Session &) = delete;
+    Session &operator=(const Session &obj) = delete;
+    Session(Session &&) = delete;
+    Session &operator=(Session &&) = delete;
+
+    /**
+     * @brief Leave the epoch of this session.
+     *
+     */
+    ~Session() = default;
+
+   private:
+    friend class DescriptorBase;
+    friend class ::dbgroup::atomic::aopt::MwCASDomain;
+
+    /**
+     * @brief Enter an epoch of a given domain for a new session.
+     *
+     * @param domain_id the ID of a domain.
+     */
+    explicit Session(const size_t domain_id)
+        : domain_id_{domain_id}, guard_{GetDomain(domain_id).gc->CreateEpochGuard()}
+    {
+    }
+
+    /// the ID of a domain that this session protects
+    size_t domain_id_{};
+
+    /// an epoch guard to protect descriptors from GC
+    decltype(std::declval<EpochBasedGC_t &>().CreateEpochGuard()) guard_;
+  };
+
+  /*################################################################################################
+   * Public constructors and assignment operators
+   *##############################################################################################*/
+
+  DescriptorBase(const DescriptorBase &) = delete;
+  DescriptorBase &operator=(const DescriptorBase &obj) = delete;
+  DescriptorBase(DescriptorBase &&) = delete;
+  DescriptorBase &operator=(DescriptorBase &&) = delete;
+
+  /*################################################################################################
+   * Public getters/setters
+   *##############################################################################################*/
+
+  /**
+   * @return the number of registered MwCAS targets.
+   */
+  [[nodiscard]] constexpr auto
+  Size() const  //
+      -> size_t
+  {
+    return target_count_;
+  }
+
+  /**
+   * @return the current status of this descriptor.
+   */
+  [[nodiscard]] auto
+  GetStatus() const  //
+      -> Status
+  {
+    return status_.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @return the usage of per-thread descriptor pools in the default domain.
+   */
+  static auto
+  GetPoolStatistics()  //
+      -> PoolStatistics
+  {
+    return GetPoolStatistics(kDefaultDomainID);
+  }
+
+  /**
+   * @return events in MwCAS operations of the default domain aggregated from all the
+   * threads.
+   *
+   * Note that the values are always zero unless MWCAS_AOPT_ENABLE_STATISTICS is defined.
+   */
+  static auto
+  GetStatistics()  //
+      -> MwCASStatistics
+  {
+    return GetStatistics(kDefaultDomainID);
+  }
+
+  /*################################################################################################
+   * Public utility functions
+   *##############################################################################################*/
+
+  /**
+   * @brief Start garbage collection for AOPT descriptors in the default domain.
+   *
+   * Note that this function must be called before performing AOPT-based MwCAS via static
+   * functions. GC is shared by descriptors of all the capacities in the default domain.
+   *
+   * @param gc_interval interval for GC in microseconds.
+   * @param gc_thread_num the number of worker threads to release garbages.
+   */
+  static void
+  StartGC(  //
+      const size_t gc_interval = 100000,
+      const size_t gc_thread_num = 1)
+  {
+    StartDomain(kDefaultDomainID, gc_interval, gc_thread_num);
+  }
+
+  /**
+   * @brief Stop garbage collection for AOPT descriptors in the default domain.
+   *
+   * Descriptors retained by threads are finalized before stopping GC, and so no thread
+   * may use the default domain concurrently.
+   */
+  static void
+  StopGC()
+  {
+    StopDomain(kDefaultDomainID);
+  }
+
+  /**
+   * @brief Finalize finished descriptors retained by the current thread.
+   *
+   * Each thread finalizes its finished descriptors in batches, and so target words keep
+   * pointing to descriptors until the next batch. A thread that stops performing MwCAS
+   * for a while (e.g., before waiting for I/O) can call this function to let readers
+   * access the target words directly and GC release the descriptors.
+   *
+   */
+  static void
+  FlushFinishedDescriptors()
+  {
+    FlushFinishedDescriptors(kDefaultDomainID);
+  }
+
+  /**
+   * @brief Read a value from a given memory address.
+   * \e NOTE: if a memory address is included in MwCAS target fields, it must be read via
+   * this function.
+   *
+   * If a target word is being updated by an active MwCAS operation, the HELPING policy
+   * finishes the operation and returns its result. The NON_HELPING policy returns the
+   * expected value of the operation instead, which is valid because an active
+   * operation has not been linearized yet. The latter is suitable for read-mostly
+   * workloads because readers do not pay the costs of other threads' writes. However,
+   * an operation with compare-only targets (e.g., RDCSS) is linearized when they are
+   * validated, which precedes setting its status. Thus, the NON_HELPING policy finishes
+   * such operations as well as the HELPING policy.
+   *
+   * Reading a 16-byte target is more costly than an 8-byte one. Unless built with AVX
+   * (e.g., -mavx), each read runs lock cmpxchg16b, which obtains the cache line
+   * exclusively and so contends with other readers of the same target. With AVX, a read
+   * is a plain 16-byte load while the target does not contain a descriptor.
+   *
+   * @tparam T an expected class of a target field
+   * @tparam kPolicy a policy for active MwCAS operations
+   * @tparam ContentionManager a class to decide when to help active MwCAS operations
+   * @param addr a target memory address to read
+   * @return a read value
+   */
+  template <class T,
+            ReadPolicy kPolicy = ReadPolicy::HELPING,
+            class ContentionManager = EagerHelping>
+  static auto
+  Read(void *addr)  //
+      -> T
+  {
+    const Session session{};
+    return Read<T, kPolicy, ContentionManager>(addr, session);
+  }
+
+  /**
+   * @brief Read a value from a given memory address in a given session.
+   *
+   * @tparam T an expected class of a target field
+   * @tparam kPolicy a policy for active MwCAS operations
+   * @tparam ContentionManager a class to decide when to help active MwCAS operations
+   * @param addr a target memory address to read
+   * @param session a session that protects descriptors in the target address
+   * @return a read value
+   */
+  template <class T,
+            ReadPolicy kPolicy = ReadPolicy::HELPING,
+            class ContentionManager = EagerHelping>
+  static auto
+  Read(  //
+      void *addr,
+      [[maybe_unused]] const Session &session)  //
+      -> T
+  {
+    return ReadInternal<kPolicy, ContentionManager, TargetField_t<T>>(addr, nullptr)
+        .second.template GetTargetData<T>();
+  }
+
+  /**
+   * @brief Read values from contiguous target words.
+   *
+   * @tparam T an expected class of target fields
+   * @tparam kPolicy a policy for active MwCAS operations
+   * @tparam ContentionManager a class to decide when to help active MwCAS operations
+   * @param addr the address of the first target word
+   * @param n the number of target words to read
+   * @param out an output array for read values
+   */
+  template <class T,
+            ReadPolicy kPolicy = ReadPolicy::HELPING,
+            class ContentionManager = EagerHelping>
+  static void
+  ReadRange(  //
+      void *addr,
+      const size_t n,
+      T *out)
+  {
+    const Session session{};
+    ReadRange<T, kPolicy, ContentionManager>(addr, n, out, session);
+  }
+
+  /**
+   * @brief Read values from contiguous target words in a given session.
+   *
+   * This function copies each cache line of target words in bulk and checks their
+   * descriptor flags at once (see CopyWords), and so only the words that contain word
+   * descriptors are read one by one as with Read. The words before the first cache-line
+   * boundary and after the last one are read one by one as well, which keeps each bulk
+   * copy within a cache line. Each value is read atomically, but the values are not a
+   * consistent snapshot (use ReadSnapshot if needed).
+   *
+   * @tparam T an expected class of target fields
+   * @tparam kPolicy a policy for active MwCAS operations
+   * @tparam ContentionManager a class to decide when to help active MwCAS operations
+   * @param addr the address of the first target word
+   * @param n the number of target words to read
+   * @param out an output array for read values
+   * @param session a session that protects descriptors in the target addresses
+   */
+  template <class T,
+            ReadPolicy kPolicy = ReadPolicy::HELPING,
+            class ContentionManager = EagerHelping>
+  static void
+  ReadRange(  //
+      void *addr,
+      const size_t n,
+      T *out,
+      const Session &session)
+  {
+    static_assert(sizeof(T) == kWordSize);
+    static_assert(CanMwCAS<T>());
+
+    auto *words = static_cast<MwCASField *>(addr);
+    const auto offset = reinterpret_cast<uintptr_t>(addr) % kCacheLineSize;  // NOLINT
+    const auto head_num = std::min((kCacheLineSize - offset) % kCacheLineSize / kWordSize, n);
+    size_t i = 0;
+    for (; i < head_num; ++i) {
+      out[i] = Read<T, kPolicy, ContentionManager>(words + i, session);
+    }
+    for (; i + kCopyWordNum <= n; i += kCopyWordNum) {
+      for (auto mask = CopyWords(words + i, out + i); mask != 0; mask &= mask - 1) {
+        // only the words with descriptors are read again
+        const auto j = i + __builtin_ctz(mask);
+        out[j] = Read<T, kPolicy, ContentionManager>(words + j, session);
+      }
+    }
+    for (; i < n; ++i) {
+      out[i] = Read<T, kPolicy, ContentionManager>(words + i, session);
+    }
+
+    // prevent the following accesses from being reordered before copying the words
+    std::atomic_thread_fence(std::memory_order_acquire);
+  }
+
+ protected:
+  /*################################################################################################
+   * Protected constructors
+   *##############################################################################################*/
+
+  /**
+   * @brief Construct an empty descriptor header.
+   *
+   * @param domain_id the ID of a domain that this descriptor belongs to.
+   * @param layout the layout of this descriptor page.
+   */
+  constexpr explicit DescriptorBase(  //
+      const size_t domain_id = kDefaultDomainID,
+      const Layout layout = Layout::WORDS)
+      : layout_{layout}, domain_id_{static_cast<uint16_t>(domain_id)}
+  {
+  }
+
+  /*################################################################################################
+   * Protected destructors
+   *##############################################################################################*/
+
+  /**
+   * @brief Destroy the DescriptorBase object.
+   *
+   */
+  ~DescriptorBase() = default;
+
+  /*################################################################################################
+   * Protected utility functions
+   *##############################################################################################*/
+
+  /**
+   * @param domain_id the ID of a domain that a new descriptor belongs to.
+   * @return a page to construct a new descriptor.
+   */
+  static auto
+  GetPage(const size_t domain_id)  //
+      -> void *
+  {
+    return GetLocalState(domain_id).pool.Get(GetDomain(domain_id).gc.get());
+  }
+
+  /**
+   * @return the ID of a domain that this descriptor belongs to.
+   */
+  [[nodiscard]] constexpr auto
+  GetDomainID() const  //
+      -> size_t
+  {
+    return domain_id_;
+  }
+
+  /**
+   * @param session a session to be used with this descriptor.
+   * @retval true if a given session protects the domain of this descriptor.
+   * @retval false otherwise.
+   */
+  [[nodiscard]] auto
+  IsProtectedBy(const Session &session) const  //
+      -> bool
+  {
+    return session.domain_id_ == domain_id_;
+  }
+
+  /**
+   * @return a new session in the domain of this descriptor.
+   */
+  [[nodiscard]] auto
+  CreateSession() const  //
+      -> Session
+  {
+    return Session{domain_id_};
+  }
+
+  /**
+   * @return the address of word descriptors that follow this header.
+   */
+  [[nodiscard]] auto
+  GetWords()  //
+      -> WordDescriptor *
+  {
+    return reinterpret_cast<WordDescriptor *>(  // NOLINT
+        reinterpret_cast<std::byte *>(this) + kDescriptorHeaderSize);
+  }
+
+  /**
+   * @return the address of word descriptors that follow the base address of a range.
+   */
+  [[nodiscard]] auto
+  GetRangeWords()  //
+      -> RangeWordDescriptor *
+  {
+    return reinterpret_cast<RangeWordDescriptor *>(  // NOLINT
+        reinterpret_cast<std::byte *>(this) + kRangeWordsOffset);
+  }
+
+  /**
+   * @return the address of pointers to extension pages that follow the base address.
+   */
+  [[nodiscard]] auto
+  GetRangePages()  //
+      -> DescriptorBase **
+  {
+    return reinterpret_cast<DescriptorBase **>(  // NOLINT
+        reinterpret_cast<std::byte *>(this) + kRangeWordsOffset);
+  }
+
+  /**
+   * @return the number of extension pages that retain the words of this descriptor.
+   */
+  [[nodiscard]] constexpr auto
+  GetRangePageNum() const  //
+      -> size_t
+  {
+    if (layout_ != Layout::RANGE || target_count_ <= kRangeWordsPerPage) return 0;
+    return (target_count_ + kRangeWordsPerPage - 1) / kRangeWordsPerPage;
+  }
+
+  /**
+   * @param pos the position of a word in the range of this descriptor.
+   * @return the word descriptor of the word.
+   */
+  [[nodiscard]] auto
+  GetRangeWord(const size_t pos)  //
+      -> RangeWordDescriptor *
+  {
+    if (target_count_ <= kRangeWordsPerPage) return GetRangeWords() + pos;
+    auto *page = GetRangePages()[pos / kRangeWordsPerPage];
+    return page->GetRangeWords() + pos % kRangeWordsPerPage;
+  }
+
+  /**
+   * @param pos the position of a word in the range of this descriptor.
+   * @return the target address of the word.
+   */
+  [[nodiscard]] auto
+  GetRangeAddress(const size_t pos)  //
+      -> MwCASField *
+  {
+    auto *base = reinterpret_cast<MwCASField **>(  // NOLINT
+        reinterpret_cast<std::byte *>(this) + kDescriptorHeaderSize);
+    return *base + pos;
+  }
+
+  /**
+   * @param word a word descriptor in any descriptor.
+   * @return the descriptor that contains a given word descriptor.
+   */
+  static auto
+  GetParent(const void *word)  //
+      -> DescriptorBase *
+  {
+    constexpr auto kPageMask = ~(kDescriptorPageSize - 1);
+    auto *page = reinterpret_cast<DescriptorBase *>(  // NOLINT
+        reinterpret_cast<uintptr_t>(word) & kPageMask);
+    if (page->layout_ != Layout::RANGE_EXTENSION) return page;
+
+    // an extension page retains its range descriptor instead of a base address
+    return *reinterpret_cast<DescriptorBase **>(  // NOLINT
+        reinterpret_cast<std::byte *>(page) + kDescriptorHeaderSize);
+  }
+
+  /**
+   * @return the number of targets to be updated (i.e., except for compare-only targets).
+   */
+  [[nodiscard]] constexpr auto
+  GetWriteCount() const  //
+      -> size_t
+  {
+    return write_count_;
+  }
+
+  /**
+   * @brief Register a new MwCAS target with this descriptor.
+   *
+   * A double-width target (i.e., sizeof(T) == 16) must be aligned to 16 bytes and uses
+   * two word descriptors.
+   *
+   * @tparam T a class of a target
+   * @param addr a target memory address
+   * @param old_val an expected value of a target field
+   * @param new_val an inserting value into a target field
+   * @param capacity the maximum number of word descriptors in this descriptor
+   * @param is_compare_only a flag to validate the target without updating it.
+   * @retval true if the target is registered.
+   * @retval false if this descriptor is full or the address has been already registered.
+   */
+  template <class T>
+  auto
+  AddTarget(  //
+      void *addr,
+      const T old_val,
+      const T new_val,
+      const size_t capacity,
+      const bool is_compare_only = false)  //
+      -> bool
+  {
+    if (target_count_ + GetWordNum<T>() > capacity) return false;
+    return AddWords(MakeWords(MwCASTarget<T>{addr, old_val, new_val}), is_compare_only);
+  }
+
+  /**
+   * @brief Register word descriptors of a new target with this descriptor.
+   *
+   * Targets to be updated are placed before compare-only ones so that descriptors are
+   * installed into a prefix of word descriptors.
+   *
+   * @tparam kWidth the number of word descriptors of a new target.
+   * @param new_words word descriptors of a new target.
+   * @param is_compare_only a flag to validate the target without updating it.
+   * @retval true if the target is registered.
+   * @retval false if any target address has been already registered.
+   */
+  template <size_t kWidth>
+  auto
+  AddWords(  //
+      const std::array<WordDescriptor, kWidth> &new_words,
+      const bool is_compare_only)  //
+      -> bool
+  {
+    auto *words = GetWords();
+    for (size_t i = 0; i < target_count_; ++i) {
+      for (const auto &word : new_words) {
+        if (words[i].GetAddress() == word.GetAddress()) return false;
+      }
+    }
+
+    for (size_t i = 0; i < kWidth; ++i) {
+      new (words + target_count_ + i) WordDescriptor{new_words[i]};
+    }
+    if (!is_compare_only) {
+      // move compare-only targets behind the new one
+      std::rotate(words + write_count_, words + target_count_, words + target_count_ + kWidth);
+      write_count_ += kWidth;
+    }
+    target_count_ += kWidth;
+    return true;
+  }
+
+  /**
+   * @brief Register all the targets of an empty descriptor at once.
+   *
+   * Since the number of word descriptors is known at compile time, this function skips
+   * capacity checks and the reordering of compare-only targets, and the check of
+   * duplicate addresses is unrolled for the number. If any address is duplicated, this
+   * descriptor is left empty as AddTarget leaves it unchanged.
+   *
+   * @tparam Ts classes of targets.
+   * @param targets MwCAS targets to be updated.
+   * @retval true if the targets are registered.
+   * @retval false if target addresses are not distinct.
+   */
+  template <class... Ts>
+  [[nodiscard]] auto
+  SetTargets(const MwCASTarget<Ts> &...targets)  //
+      -> bool
+  {
+    (PutWords(MakeWords(targets)), ...);
+    write_count_ = target_count_;
+    return HasDistinctAddresses<(GetWordNum<Ts>() + ...)>();
+  }
+
+  /**
+   * @brief Register a target to be updated and its control word with an empty descriptor.
+   *
+   * The control word is registered as a compare-only target, and so it is validated
+   * after embedding a descriptor into the target but never occupied by the descriptor.
+   *
+   * @tparam C a class of a control word.
+   * @tparam T a class of a target.
+   * @param control a control word and its expected value.
+   * @param target a MwCAS target to be updated.
+   * @retval true if the targets are registered.
+   * @retval false if the control word overlaps the target.
+   */
+  template <class C, class T>
+  [[nodiscard]] auto
+  SetRDCSSTargets(  //
+      const CompareTarget<C> &control,
+      const MwCASTarget<T> &target)  //
+      -> bool
+  {
+    PutWords(MakeWords(target));
+    write_count_ = target_count_;
+    PutWords(MakeWords(MwCASTarget<C>{control.addr, control.expected, control.expected}));
+    return HasDistinctAddresses<GetWordNum<C>() + GetWordNum<T>()>();
+  }
+
+  /**
+   * @brief Create word descriptors of a given target.
+   *
+   * A double-width target (i.e., sizeof(T) == 16) must be aligned to 16 bytes and uses
+   * two word descriptors.
+   *
+   * @tparam T a class of a target
+   * @param target a MwCAS target.
+   * @return word descriptors of the target.
+   */
+  template <class T>
+  static auto
+  MakeWords(const MwCASTarget<T> &target)  //
+      -> std::array<WordDescriptor, GetWordNum<T>()>
+  {
+    if constexpr (sizeof(T) == kWideWordSize) {
+      static_assert(CanMwCAS<T>());
+      assert(reinterpret_cast<uintptr_t>(target.addr) % kWideWordSize == 0);  // NOLINT
+
+      const auto old_wide = WideField::From(target.old_val);
+      const auto new_wide = WideField::From(target.new_val);
+      auto *hi_addr = static_cast<std::byte *>(target.addr) + kWordSize;
+      return {WordDescriptor{target.addr, old_wide.lo, new_wide.lo, true},
+              WordDescriptor{hi_addr, old_wide.hi, new_wide.hi}};
+    } else {
+      return {WordDescriptor{target.addr, target.old_val, target.new_val}};
+    }
+  }
+
+  /**
+   * @brief Append word descriptors without any check.
+   *
+   * @tparam kWidth the number of word descriptors of a new target.
+   * @param new_words word descriptors of a new target.
+   */
+  template <size_t kWidth>
+  void
+  PutWords(const std::array<WordDescriptor, kWidth> &new_words)
+  {
+    auto *words = GetWords();
+    for (const auto &word : new_words) {
+      new (words + target_count_++) WordDescriptor{word};
+    }
+  }
+
+  /**
+   * @brief Check the addresses of registered targets and clear them if duplicated.
+   *
+   * @tparam kCount the number of registered word descriptors.
+   * @retval true if all the registered targets have distinct addresses.
+   * @retval false otherwise.
+   */
+  template <size_t kCount>
+  [[nodiscard]] auto
+  HasDistinctAddresses()  //
+      -> bool
+  {
+    assert(target_count_ == kCount);
+
+    auto *words = GetWords();
+    for (size_t i = 0; i + 1 < kCount; ++i) {
+      for (size_t j = i + 1; j < kCount; ++j) {
+        if (words[i].GetAddress() != words[j].GetAddress()) continue;
+
+        target_count_ = 0;
+        write_count_ = 0;
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Register the targets of a given descriptor with this empty descriptor.
+   *
+   * @param src a descriptor whose targets have been registered.
+   */
+  void
+  CopyTargets(DescriptorBase &src)
+  {
+    assert(layout_ == Layout::WORDS && src.layout_ == Layout::WORDS);
+    assert(target_count_ == 0);
+
+    auto *words = GetWords();
+    auto *src_words = src.GetWords();
+    for (size_t i = 0; i < src.target_count_; ++i) {
+      new (words + i) WordDescriptor{src_words[i]};
+    }
+    target_count_ = src.target_count_;
+    write_count_ = src.write_count_;
+  }
+
+  /**
+   * @brief Register contiguous target words with this empty range descriptor.
+   *
+   * @tparam T a class of targets
+   * @param addr the address of the first target word
+   * @param old_vals expected values of the target words
+   * @param new_vals inserting values into the target words
+   * @param n the number of target words
+   */
+  template <class T>
+  void
+  SetRangeTargets(  //
+      void *addr,
+      const T *old_vals,
+      const T *new_vals,
+      const size_t n)
+  {
+    assert(layout_ == Layout::RANGE);
+    assert(reinterpret_cast<uintptr_t>(addr) % kWordSize == 0);  // NOLINT
+    assert(n <= kMaxRangeLength);
+
+    *reinterpret_cast<void **>(  // NOLINT
+        reinterpret_cast<std::byte *>(this) + kDescriptorHeaderSize) = addr;
+    target_count_ = n;
+    write_count_ = n;
+
+    // a long range places its words in extension pages that refer to this descriptor
+    auto **pages = GetRangePages();
+    for (size_t i = 0; i < GetRangePageNum(); ++i) {
+      pages[i] = new (GetPage(domain_id_)) DescriptorBase{domain_id_, Layout::RANGE_EXTENSION};
+      *reinterpret_cast<DescriptorBase **>(  // NOLINT
+          reinterpret_cast<std::byte *>(pages[i]) + kDescriptorHeaderSize) = this;
+    }
+    for (size_t i = 0; i < n; ++i) {
+      new (GetRangeWord(i)) RangeWordDescriptor{old_vals[i], new_vals[i]};
+    }
+  }
+
+  /**
+   * @brief Sort registered targets to be updated by their addresses.
+   *
+   * Installing word descriptors in the same order prevents MwCAS operations on
+   * overlapping words from blocking each other and triggering chains of helping. This
+   * function uses an odd-even transposition sort, which is a sorting network unrolled
+   * for each number of targets. Compare-only targets are not sorted because they are
+   * not installed. Since target addresses do not overlap, the two word descriptors of a
+   * double-width target remain adjacent after sorting.
+   *
+   * @tparam kMaxCount the maximum number of targets (i.e., the capacity).
+   */
+  template <size_t kMaxCount>
+  void
+  SortWords()
+  {
+    if constexpr (kMaxCount > 1) {
+      if (write_count_ < kMaxCount) {
+        SortWords<kMaxCount - 1>();
+        return;
+      }
+
+      auto *words = GetWords();
+      for (size_t i = 0; i < kMaxCount; ++i) {
+        for (size_t j = i % 2; j + 1 < kMaxCount; j += 2) {
+          if (std::less<void *>{}(words[j + 1].GetAddress(), words[j].GetAddress())) {
+            std::swap(words[j], words[j + 1]);
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Validate the expected values of all the targets without installing descriptors.
+   *
+   * This function does nothing if pre-validation is disabled. Since this function does
+   * not help active MwCAS operations, the targets of them are regarded as the expected
+   * values of them. If validation fails, this descriptor has not been published, and so
+   * a caller can recycle it immediately.
+   *
+   * @param result an output for the details of this operation.
+   * @retval true if all the targets have the expected values.
+   * @retval false otherwise.
+   */
+  auto
+  PreValidate(MwCASResult &result)  //
+      -> bool
+  {
+    if constexpr (kUsePreValidation) {
+      if (!HasExpectedValues<ReadPolicy::NON_HELPING>(0, &result)) {
+        Statistics::Add(domain_id_, PRE_VALIDATION_FAILURE);
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  /**
+   * @brief Perform RDCSS (i.e., a MwCAS with one write target and compare-only targets).
+   *
+   * Since compare-only targets are not locked, this function checks them before
+   * publishing this descriptor regardless of pre-validation settings. If a control word
+   * has already been changed, the operation fails without writing any target word, and
+   * a caller can directly recycle or reuse the descriptor. Since this check only filters
+   * out stale operations, it uses the expected values of active descriptors. Otherwise,
+   * this function embeds the descriptor only into the write target and then validates
+   * the control words again as with MwCASInternal. Thus, RDCSS operations whose targets
+   * are the control words of each other are resolved by ValidateCompareTargets as well.
+   * A caller must enter an epoch in advance.
+   *
+   * @tparam ContentionManager a class to decide when to help active MwCAS operations
+   * @param result an output for the details of this operation.
+   * @retval true if this descriptor has been published and so must be reclaimed by GC
+   * @retval false if other threads have never observed this descriptor
+   */
+  template <class ContentionManager>
+  auto
+  RDCSSInternal(MwCASResult &result)  //
+      -> bool
+  {
+    if (!HasExpectedValues<ReadPolicy::NON_HELPING>(write_count_, &result)) {
+      Statistics::Add(domain_id_, PRE_VALIDATION_FAILURE);
+      return false;
+    }
+
+    return MwCASInternal<ContentionManager>(&result);
+  }
+
+  /**
+   * @brief Return this unpublished descriptor to the pool of the current thread.
+   *
+   */
+  void
+  Recycle()
+  {
+    auto &pool = GetLocalState(domain_id_).pool;
+    auto **pages = GetRangePages();
+    for (size_t i = 0; i < GetRangePageNum(); ++i) {
+      pool.Release(reinterpret_cast<DescriptorPage *>(pages[i]));  // NOLINT
+    }
+    pool.Release(reinterpret_cast<DescriptorPage *>(this));  // NOLINT
+  }
+
+  /**
+   * @brief Perform a single-word CAS by using the sole registered target.
+   *
+   * Since this function never embeds this descriptor into a target word, other threads
+   * cannot see it. Thus, a caller can skip GC and directly recycle or reuse this
+   * descriptor. A caller must enter an epoch in advance.
+   *
+   * @tparam ContentionManager a class to decide when to help active MwCAS operations
+   * @param result an output for the details of this operation.
+   */
+  template <class ContentionManager>
+  void
+  SingleWordCAS(MwCASResult &result)
+  {
+    auto *word_desc = GetWords();
+    while (true) {
+      // an active descriptor in the target word is finished by helping
+      auto &&[content, value] =
+          ReadInternal<ReadPolicy::HELPING, ContentionManager>(word_desc->GetAddress(), this);
+      if (value != word_desc->GetOldValue()) {
+        result = MwCASResult{word_desc->GetAddress(), value};
+        break;
+      }
+
+      // a finished descriptor may remain, but it has the same logical value
+      if (word_desc->UpdateDirectly(content)) break;
+    }
+  }
+
+  /**
+   * @brief Perform a MwCAS operation by using registered targets.
+   *
+   * This function is called by the owner of this descriptor and threads that help it.
+   * A caller must enter an epoch in advance.
+   *
+   * If a target word is occupied by another active descriptor, this function helps it
+   * by using a worklist instead of recursive calls. The worklist is bounded by
+   * kMaxHelpDepth, and a thread at the limit replaces the deepest helped descriptor with
+   * its blocker instead of extending a helping chain. Since helpers install words from
+   * the first one, the replaced descriptor is helped again after its blocker finishes.
+   * Thus, a thread never waits for other threads, which retains lock-freedom.
+   *
+   * @tparam ContentionManager a class to decide when to help active MwCAS operations
+   * @param result an output for the details of this operation (only for an owner).
+   * @retval true if this descriptor has been published (i.e., embedded into any word)
+   * and so must be reclaimed by GC
+   * @retval false if an owner has finished this descriptor before publishing it, and so
+   * the owner can directly recycle or reuse it without waiting for GC
+   */
+  template <class ContentionManager>
+  auto
+  MwCASInternal(MwCASResult *result = nullptr)  //
+      -> bool
+  {
+    // each entry retains a descriptor and the position of a word to be installed next
+    std::array<std::pair<DescriptorBase *, size_t>, kMaxHelpDepth + 1> worklist{};
+    worklist[0] = {this, 0};
+    size_t depth = 0;
+
+    ContentionManager cm{};
+    while (true) {
+      auto &[desc, pos] = worklist[depth];
+      auto *blocker = desc->InstallWords(pos, (depth == 0) ? result : nullptr, cm);
+      if (blocker == nullptr) {
+        // the descriptor has finished, so resume the descriptor blocked by it
+        if (depth == 0) break;
+        --depth;
+      } else if (cm.OnActiveDescriptor()) {
+        if (depth == kMaxHelpDepth) {
+          // avoid a long helping chain by helping the blocker instead of the descriptor
+          Statistics::Add(domain_id_, HELP_DEPTH_LIMIT);
+          worklist[depth] = {blocker, 0};
+        } else {
+          worklist[++depth] = {blocker, 0};
+          Statistics::UpdateMax(domain_id_, MAX_HELP_DEPTH, depth);
+        }
+        Statistics::Add(domain_id_, HELP);
+      }
+    }
+
+    const auto mwcas_success = GetStatus() == Status::SUCCESSFUL;
+    if (result == nullptr) return true;
+
+    if (mwcas_success) {
+      // this thread may observe words that have been already finalized
+      *result = MwCASResult{};
+    } else if (*result) {
+      // another thread has detected a mismatched word or a conflict, so search it
+      *result = FindMismatchedWord<ContentionManager>();
+    }
+
+    // if no word has been embedded, other threads have never observed this descriptor
+    const auto published = worklist[0].second > 0;
+    if (!published && !mwcas_success) {
+      Statistics::Add(domain_id_, UNPUBLISHED_FAILURE);
+    }
+    return published;
+  }
+
+  /**
+   * @brief Read the values of multiple targets that coexisted at a certain moment.
+   *
+   * This function reads the targets twice (i.e., double collect). The first collect
+   * finishes active MwCAS operations on the targets, and the second one confirms that
+   * no raw word has been modified since the first one. If so, the values coexisted
+   * between the two collects; otherwise, this function retries. Since a session
+   * prevents descriptors from being reused, a descriptor pointer observed by both the
+   * collects refers to the same finished operation. However, as with any double
+   * collect, a target that is changed and restored to the same value between the
+   * collects is not detected, and so this function requires that targets do not return
+   * to previous values during a call (e.g., monotonic counters or versioned words).
+   *
+   * This function allocates no descriptor and writes no target word except for helping
+   * active MwCAS operations. Note that a double-width target may be read by a CAS instruction
+   * (see Read).
+   *
+   * @tparam ContentionManager a class to decide when to help active MwCAS operations
+   * @tparam Ts classes of target fields
+   * @param session a session that protects descriptors in the target addresses
+   * @param addrs target memory addresses to read
+   * @return a tuple of read values
+   */
+  template <class ContentionManager, class... Ts>
+  static auto
+  ReadSnapshot(  //
+      const Session &session,
+      TargetAddress<Ts>... addrs)  //
+      -> std::tuple<Ts...>
+  {
+    return ReadSnapshotInternal<ContentionManager, Ts...>(session.domain_id_, {addrs...},
+                                                          std::index_sequence_for<Ts...>{});
+  }
+
+ private:
+  friend class ::dbgroup::atomic::aopt::MwCASDomain;
+
+  /*################################################################################################
+   * Internal enum and classes
+   *##############################################################################################*/
+
+  /**
+   * @brief An enumeration for representing the outcome of an attempt to embed a word.
+   *
+   */
+  enum class EmbedState
+  {
+    EMBEDDED,
+    BLOCKED,
+    MISMATCHED,
+    FINISHED,
+    RETRY,
+  };
+
+  /**
+   * @brief A class to manage finished AOPT descriptors of one domain.
+   *
+   * If background finalization is enabled, each list is guarded by a spinlock, which is
+   * only contended when a finalizer thread of the domain flushes an idle list. Retained
+   * descriptors must be flushed before destroying a list.
+   *
+   */
+  class FinishedDescriptors
+  {
+   public:
+    /*##############################################################################################
+     * Public constructors and assignment operators
+     *############################################################################################*/
+
+    /**
+     * @brief Create a new FinishedDescriptors object.
+     *
+     * @param domain_id the ID of a domain that retained descriptors belong to.
+     */
+    explicit FinishedDescriptors(const size_t domain_id) : domain_id_{domain_id} {}
+
+    FinishedDescriptors(const FinishedDescriptors &) = delete;
+    FinishedDescriptors &operator=(const FinishedDescriptors &obj) = delete;
+    FinishedDescriptors(FinishedDescriptors &&) = delete;
+    FinishedDescriptors &operator=(FinishedDescriptors &&) = delete;
+
+    /*##############################################################################################
+     * Public destructors
+     *############################################################################################*/
+
+    /**
+     * @brief Destroy the FinishedDescriptors object.
+     *
+     */
+    ~FinishedDescriptors() = default;
+
+    /*##############################################################################################
+     * Public utility functions
+     *############################################################################################*/
+
+    /**
+     * @brief Register a finished descriptor with the internal list.
+     *
+     * If the number of finished descriptors reaches a certain threshold, this function
+     * invoke finalization of finished descriptors to release them.
+     *
+     * @param desc a finished descriptor.
+     */
+    void
+    RetireForCleanUp(DescriptorBase *desc)
+    {
+      Lock();
+      if (desc_num_ >= kMaxFinishedDescriptors) {
+        FinalizeFinishedDescriptors();
+      }
+      desc_arr_[desc_num_++] = desc;
+      Unlock();
+    }
+
+    /**
+     * @brief Finalize all the descriptors in the internal list.
+     *
+     * A caller must enter an epoch in advance.
+     */
+    void
+    Flush()
+    {
+      Lock();
+      FinalizeFinishedDescriptors();
+      Unlock();
+    }
+
+    /**
+     * @brief Finalize descriptors if the owner has not updated this list for a while.
+     *
+     * This function is called by a finalizer thread in every interval, and so retained
+     * descriptors are finalized within two intervals. A caller must enter an epoch in
+     * advance.
+     */
+    void
+    FlushIfIdle()
+    {
+      if (lock_.exchange(true, std::memory_order_acquire)) return;  // the owner is active
+
+      if (desc_num_ > 0 && finalized_num_ == checked_num_) {
+        // descriptors retained at the last check have not been finalized yet
+        FinalizeFinishedDescriptors();
+      }
+      checked_num_ = (desc_num_ > 0) ? finalized_num_ : kNotChecked;
+      Unlock();
+    }
+
+   private:
+    /*##############################################################################################
+     * Internal constants
+     *############################################################################################*/
+
+    /// a sentinel to represent a finalizer has not observed retained descriptors
+    static constexpr size_t kNotChecked = ~0UL;
+
+    /*##############################################################################################
+     * Internal utility functions
+     *############################################################################################*/
+
+    /**
+     * @brief Acquire the lock of this list if background finalization is enabled.
+     *
+     */
+    void
+    Lock()
+    {
+      if constexpr (kFinalizeInterval > 0) {
+        while (lock_.exchange(true, std::memory_order_acquire)) {
+          SpinWait(1);
+        }
+      }
+    }
+
+    /**
+     * @brief Release the lock of this list if background finalization is enabled.
+     *
+     */
+    void
+    Unlock()
+    {
+      if constexpr (kFinalizeInterval > 0) {
+        lock_.store(false, std::memory_order_release);
+      }
+    }
+
+    /**
+     * @brief Perform finalization for AOPT-based MwCAS.
+     *
+     * After this function, finished descriptors become targets of internal GC.
+     */
+    void
+    FinalizeFinishedDescriptors()
+    {
+      if (desc_num_ > 0) {
+        Statistics::Add(domain_id_, FINALIZE);
+        Statistics::Add(domain_id_, FINALIZED_DESCRIPTOR, desc_num_);
+        Statistics::UpdateMax(domain_id_, MAX_FINALIZE_SIZE, desc_num_);
+      }
+
+      auto *gc = GetDomain(domain_id_).gc.get();
+      for (size_t i = 0; i < desc_num_; ++i) {
+        auto *desc = desc_arr_[i];
+        desc->CompleteWords();
+        auto **pages = desc->GetRangePages();
+        for (size_t j = 0; j < desc->GetRangePageNum(); ++j) {
+          gc->AddGarbage(reinterpret_cast<DescriptorPage *>(pages[j]));  // NOLINT
+        }
+        gc->AddGarbage(reinterpret_cast<DescriptorPage *>(desc));  // NOLINT
+      }
+
+      desc_num_ = 0;
+      ++finalized_num_;
+    }
+
+    /*##############################################################################################
+     * Internal member variables
+     *############################################################################################*/
+
+    /// the ID of a domain that retained descriptors belong to
+    size_t domain_id_{};
+
+    /// pointers to finished descriptors
+    std::array<DescriptorBase *, kMaxFinishedDescriptors> desc_arr_{};
+
+    /// the current number of finished descriptors
+    size_t desc_num_{0};
+
+    /// the number of finalization performed for this list
+    size_t finalized_num_{0};
+
+    /// the number of finalization observed by the last check of a non-empty list
+    size_t checked_num_{kNotChecked};
+
+    /// a flag to represent this list is being modified
+    std::atomic_bool lock_{false};
+  };
+
+  /**
+   * @brief A struct to retain the per-thread state of one domain.
+   *
+   */
+  struct LocalState {
+    /**
+     * @brief Create an empty state of a given domain.
+     *
+     * @param domain_id the ID of a domain.
+     */
+    explicit LocalState(const size_t domain_id)
+        : pool{GetDomain(domain_id).pool_counters}, finished{domain_id}
+    {
+    }
+
+    /// a descriptor pool of a thread
+    DescriptorPool_t pool;
+
+    /// finished descriptors retained by a thread
+    FinishedDescriptors finished;
+  };
+
+  /**
+   * @brief A struct to retain the shared state of one domain.
+   *
+   * The states of all the domains are static objects, and so threads can safely check
+   * whether their local states have been released by a stopped domain. Since a domain
+   * increments its generation when it stops, a local state is valid only if it has the
+   * current generation of its domain.
+   *
+   */
+  struct Domain {
+    ~Domain() { StopFinalizer(); }
+
+    /**
+     * @brief Stop a finalizer thread if it is running.
+     *
+     */
+    void
+    StopFinalizer()
+    {
+      {
+        std::lock_guard guard{mtx};
+        is_running = false;
+      }
+      cond.notify_all();
+      if (finalizer.joinable()) {
+        finalizer.join();
+      }
+    }
+
+    /// a garbage collector for expired descriptors
+    std::unique_ptr<EpochBasedGC_t> gc{nullptr};
+
+    /// a mutex to protect the local states and the running flag
+    std::mutex mtx{};
+
+    /// a condition variable to stop a finalizer
+    std::condition_variable cond{};
+
+    /// the local states of threads that have used this domain
+    std::vector<LocalState *> states{};
+
+    /// a flag to represent a finalizer is running
+    bool is_running{false};
+
+    /// a finalizer thread
+    std::thread finalizer{};
+
+    /// the number of times that this domain has been stopped
+    std::atomic_size_t generation{0};
+
+    /// shared counters of the descriptor pools in this domain
+    PoolCounters pool_counters{};
+
+    /// a flag to represent this domain is owned by a MwCASDomain object
+    std::atomic_bool in_use{false};
+  };
+
+  /**
+   * @brief A struct to bind the local states of all the domains with a thread.
+   *
+   */
+  struct LocalStates {
+    ~LocalStates()
+    {
+      for (size_t i = 0; i < kMaxDomainNum; ++i) {
+        if (states[i] != nullptr) {
+          ReleaseLocalState(i, generations[i], states[i]);
+        }
+      }
+    }
+
+    /// the local state of each domain
+    std::array<LocalState *, kMaxDomainNum> states{};
+
+    /// the generation of each domain when its local state is created
+    std::array<size_t, kMaxDomainNum> generations{};
+  };
+
+  /*################################################################################################
+   * Internal utility functions for domains
+   *##############################################################################################*/
+
+  /**
+   * @param domain_id the ID of a domain.
+   * @return the shared state of a given domain.
+   */
+  static auto
+  GetDomain(const size_t domain_id)  //
+      -> Domain &
+  {
+    static std::array<Domain, kMaxDomainNum> domains{};
+    return domains[domain_id];
+  }
+
+  /**
+   * @param domain_id the ID of a domain.
+   * @return the state of a given domain for the current thread.
+   */
+  static auto
+  GetLocalState(const size_t domain_id)  //
+      -> LocalState &
+  {
+    thread_local LocalStates local{};
+
+    auto &domain = GetDomain(domain_id);
+    const auto generation = domain.generation.load(std::memory_order_relaxed);
+    auto *&state = local.states[domain_id];
+    if (state == nullptr || local.generations[domain_id] != generation) {
+      // the previous state (if exist) has been released when the domain stopped
+      state = new LocalState{domain_id};
+      local.generations[domain_id] = generation;
+
+      std::lock_guard guard{domain.mtx};
+      domain.states.emplace_back(state);
+    }
+    return *state;
+  }
+
+  /**
+   * @brief Finalize descriptors in a local state and release it when its thread exits.
+   *
+   * @param domain_id the ID of a domain.
+   * @param generation the generation of the domain when the state is created.
+   * @param state a local state to be released.
+   */
+  static void
+  ReleaseLocalState(  //
+      const size_t domain_id,
+      const size_t generation,
+      LocalState *state)
+  {
+    auto &domain = GetDomain(domain_id);
+    std::lock_guard guard{domain.mtx};
+    if (generation != domain.generation.load(std::memory_order_relaxed)) return;
+
+    {
+      [[maybe_unused]] auto &&epoch_guard = domain.gc->CreateEpochGuard();
+      state->finished.Flush();
+    }
+    auto &states = domain.states;
+    states.erase(std::find(states.begin(), states.end(), state));
+    delete state;
+  }
+
+  /**
+   * @brief Start GC (and a finalizer if needed) of a given domain.
+   *
+   * @param domain_id the ID of a domain.
+   * @param gc_interval interval for GC in microseconds.
+   * @param gc_thread_num the number of worker threads to release garbages.
+   */
+  static void
+  StartDomain(  //
+      const size_t domain_id,
+      const size_t gc_interval,
+      const size_t gc_thread_num)
+  {
+    auto &domain = GetDomain(domain_id);
+    domain.gc = std::make_unique<EpochBasedGC_t>(gc_interval, gc_thread_num, true);
+
+    if constexpr (kFinalizeInterval > 0) {
+      domain.is_running = true;
+      domain.finalizer = std::thread{RunFinalizer, domain_id};
+    }
+  }
+
+  /**
+   * @brief Finalize all the retained descriptors of a given domain and stop its GC.
+   *
+   * No thread may use the domain concurrently. The local states of threads are released
+   * here, and the threads create new ones if the domain is started again.
+   *
+   * @param domain_id the ID of a domain.
+   */
+  static void
+  StopDomain(const size_t domain_id)
+  {
+    auto &domain = GetDomain(domain_id);
+    if constexpr (kFinalizeInterval > 0) {
+      domain.StopFinalizer();
+    }
+
+    {
+      std::lock_guard guard{domain.mtx};
+      {
+        [[maybe_unused]] auto &&epoch_guard = domain.gc->CreateEpochGuard();
+        for (auto *state : domain.states) {
+          state->finished.Flush();
+        }
+      }
+      for (auto *state : domain.states) {
+        delete state;  // cached pages are passed to the shared pools of NUMA nodes
+      }
+      domain.states.clear();
+      domain.generation.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // release reclaimed pages by the allocator of NUMA nodes instead of leaving them to GC
+    while (auto *page = domain.gc->template GetPageIfPossible<DescriptorPage>()) {
+      DescriptorPage::operator delete(page, std::align_val_t{alignof(DescriptorPage)});
+    }
+    domain.gc.reset(nullptr);
+  }
+
+  /**
+   * @brief Reserve an unused domain and start it.
+   *
+   * @param gc_interval interval for GC in microseconds.
+   * @param gc_thread_num the number of worker threads to release garbages.
+   * @return the ID of a new domain (kMaxDomainNum if all the domains are used).
+   */
+  static auto
+  CreateDomain(  //
+      const size_t gc_interval,
+      const size_t gc_thread_num)  //
+      -> size_t
+  {
+    // the default domain is never reserved
+    for (size_t i = kDefaultDomainID + 1; i < kMaxDomainNum; ++i) {
+      auto &domain = GetDomain(i);
+      auto expected = false;
+      if (domain.in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+        // clear the counters of a previous domain with the same ID
+        domain.pool_counters.Reset();
+        Statistics::Reset(i);
+        StartDomain(i, gc_interval, gc_thread_num);
+        return i;
+      }
+    }
+    return kMaxDomainNum;
+  }
+
+  /**
+   * @brief Stop a given domain and make its ID reusable.
+   *
+   * @param domain_id the ID of a domain.
+   */
+  static void
+  DestroyDomain(const size_t domain_id)
+  {
+    StopDomain(domain_id);
+    GetDomain(domain_id).in_use.store(false, std::memory_order_release);
+  }
+
+  /**
+   * @brief Finalize finished descriptors of a given domain retained by the current thread.
+   *
+   * @param domain_id the ID of a domain.
+   */
+  static void
+  FlushFinishedDescriptors(const size_t domain_id)
+  {
+    [[maybe_unused]] auto &&guard = GetDomain(domain_id).gc->CreateEpochGuard();
+    GetLocalState(domain_id).finished.Flush();
+  }
+
+  /**
+   * @param domain_id the ID of a domain.
+   * @return the usage of per-thread descriptor pools in a given domain.
+   */
+  static auto
+  GetPoolStatistics(const size_t domain_id)  //
+      -> PoolStatistics
+  {
+    return GetDomain(domain_id).pool_counters.Load();
+  }
+
+  /**
+   * @param domain_id the ID of a domain.
+   * @return events in MwCAS operations of a given domain.
+   */
+  static auto
+  GetStatistics(const size_t domain_id)  //
+      -> MwCASStatistics
+  {
+    return Statistics::Collect(domain_id);
+  }
+
+  /*################################################################################################
+   * Internal utility functions
+   *##############################################################################################*/
+
+  /**
+   * @brief Embed word descriptors into target words until this MwCAS finishes.
+   *
+   * This function does not help other descriptors. If a target word is occupied by
+   * another active descriptor, this function returns it and a caller resumes this
+   * function with the same position after the blocker finishes.
+   *
+   * @tparam ContentionManager a class to decide how to wait for retries
+   * @param pos the position of a word to be installed next.
+   * @param result an output for the details of this operation (only for an owner). If
+   * an owner fails before embedding any word, the descriptor is not retired because a
+   * caller recycles it immediately.
+   * @param cm a contention manager of the current operation.
+   * @retval nullptr if this MwCAS operation has finished.
+   * @return an active descriptor that blocks this MwCAS operation otherwise.
+   */
+  template <class ContentionManager>
+  auto
+  InstallWords(  //
+      size_t &pos,
+      MwCASResult *result,
+      ContentionManager &cm)  //
+      -> DescriptorBase *
+  {
+    // serialize MwCAS operations by embedding a descriptor
+    auto mwcas_success = true;
+    while (pos < write_count_) {
+      DescriptorBase *blocker = nullptr;
+      EmbedState state{};
+      size_t width = 1;
+      if (layout_ == Layout::RANGE) {
+        PrefetchRange(pos);
+        state = TryEmbed<MwCASField>(GetRangeAddress(pos), GetRangeWord(pos), result, blocker);
+      } else {
+        auto *word_desc = GetWords() + pos;
+        auto *addr = word_desc->GetAddress();
+        width = word_desc->GetWidth();
+        state = (word_desc->IsWide()) ? TryEmbed<WideField>(addr, word_desc, result, blocker)
+                                      : TryEmbed<MwCASField>(addr, word_desc, result, blocker);
+      }
+      if (state == EmbedState::BLOCKED) return blocker;
+      if (state == EmbedState::FINISHED) break;
+      if (state == EmbedState::MISMATCHED) {
+        mwcas_success = false;
+        break;
+      }
+      if (state == EmbedState::RETRY) {
+        Statistics::Add(domain_id_, EMBED_FAILURE);
+        cm.OnEmbedFailure();
+        continue;
+      }
+      pos += width;
+    }
+
+    if (mwcas_success && pos == write_count_) {
+      // all the write targets are locked, so validate compare-only targets
+      mwcas_success = ValidateCompareTargets(result);
+    }
+
+    // update status of this descriptor
+    auto expected = Status::ACTIVE;
+    const auto desired = (mwcas_success) ? Status::SUCCESSFUL : Status::FAILED;
+    const auto success =
+        status_.compare_exchange_strong(expected, desired, std::memory_order_acq_rel);
+
+    if (success && (result == nullptr || pos > 0)) {
+      // if this thread finalized the published descriptor, mark it for reclamation
+      RetireForCleanUp(this);
+    }
+
+    return nullptr;
+  }
+
+  /**
+   * @brief Try to embed a word descriptor into its target word once.
+   *
+   * @tparam Field a class of target words (i.e., MwCASField or WideField).
+   * @tparam Word a class of word descriptors (i.e., WordDescriptor or RangeWordDescriptor).
+   * @param addr the target address of a word descriptor.
+   * @param word_desc a word descriptor to be embedded.
+   * @param result an output for the details of this operation (only for an owner).
+   * @param blocker an output for an active descriptor of another thread (if exist).
+   * @return the state of the target word after this attempt.
+   */
+  template <class Field, class Word>
+  auto
+  TryEmbed(  //
+      void *addr,
+      Word *word_desc,
+      MwCASResult *result,
+      DescriptorBase *&blocker)  //
+      -> EmbedState
+  {
+    auto &&[content, value] = ReadWord<Field>(addr, this, blocker);
+    if (blocker != nullptr) return EmbedState::BLOCKED;
+
+    if (content.template GetTargetData<Word *>() == word_desc) {
+      // this word already points to the right place, move on
+      return EmbedState::EMBEDDED;
+    }
+
+    if (value != GetOldValue<Field>(*word_desc)) {
+      // the expected value is different, the MwCAS fails
+      if (result != nullptr) {
+        *result = MwCASResult{addr, value};
+      }
+      return EmbedState::MISMATCHED;
+    }
+
+    if (GetStatus() != Status::ACTIVE) {
+      // this AOPT descriptor has already finished
+      return EmbedState::FINISHED;
+    }
+
+    // try to install the pointer to my descriptor
+    bool embedded{};
+    if constexpr (std::is_same_v<Word, RangeWordDescriptor>) {
+      embedded = word_desc->EmbedDescriptor(addr, content);
+    } else if constexpr (std::is_same_v<Field, WideField>) {
+      embedded = word_desc->EmbedWideDescriptor(content);
+    } else {
+      embedded = word_desc->EmbedDescriptor(content);
+    }
+    return (embedded) ? EmbedState::EMBEDDED : EmbedState::RETRY;
+  }
+
+  /**
+   * @brief Check targets from a given position have their expected values.
+   *
+   * @tparam kPolicy a policy for active MwCAS operations
+   * @tparam ContentionManager a class to decide when to help active MwCAS operations
+   * @param begin the position of the first word descriptor to be checked.
+   * @param result an output for a mismatched target and its observed value (if needed).
+   * @retval true if all the targets have the expected values.
+   * @retval false otherwise.
+   */
+  template <ReadPolicy kPolicy, class ContentionManager = EagerHelping>
+  auto
+  HasExpectedValues(  //
+      const size_t begin,
+      MwCASResult *result)  //
+      -> bool
+  {
+    if (layout_ == Layout::RANGE) {
+      for (size_t i = begin; i < target_count_; ++i) {
+        const auto expected = GetRangeWord(i)->GetOldValue();
+        auto *addr = GetRangeAddress(i);
+        if (!HasExpectedValue<kPolicy, ContentionManager>(addr, expected, result)) return false;
+      }
+      return true;
+    }
+
+    auto *words = GetWords();
+    for (size_t i = begin; i < target_count_; i += words[i].GetWidth()) {
+      const auto &word = words[i];
+      auto *addr = word.GetAddress();
+      const auto valid =
+          (word.IsWide())
+              ? HasExpectedValue<kPolicy, ContentionManager>(addr, word.GetWideOldValue(), result)
+              : HasExpectedValue<kPolicy, ContentionManager>(addr, word.GetOldValue(), result);
+      if (!valid) return false;
+    }
+    return true;
+  }
+
+  /**
+   * @tparam kPolicy a policy for active MwCAS operations
+   * @tparam ContentionManager a class to decide when to help active MwCAS operations
+   * @tparam Field a class of target words (i.e., MwCASField or WideField).
+   * @param addr the address of a target.
+   * @param expected the expected value of the target.
+   * @param result an output for a mismatched target and its observed value (if needed).
+   * @retval true if the target has the expected value.
+   * @retval false otherwise.
+   */
+  template <ReadPolicy kPolicy, class ContentionManager, class Field>
+  auto
+  HasExpectedValue(  //
+      void *addr,
+      const Field &expected,
+      MwCASResult *result)  //
+      -> bool
+  {
+    const auto value = ReadInternal<kPolicy, ContentionManager, Field>(addr, this).second;
+    if (value == expected) return true;
+
+    if (result != nullptr) {
+      *result = MwCASResult{addr, value};
+    }
+    return false;
+  }
+
+  /**
+   * @tparam Field a class of target words (i.e., MwCASField or WideField).
+   * @param word the first word descriptor of a target.
+   * @return the expected value of the target.
+   */
+  template <class Field>
+  static auto
+  GetOldValue(const WordDescriptor &word)  //
+      -> Field
+  {
+    if constexpr (std::is_same_v<Field, WideField>) {
+      return word.GetWideOldValue();
+    } else {
+      return word.GetOldValue();
+    }
+  }
+
+  /**
+   * @tparam Field a class of target words (only MwCASField for ranges).
+   * @param word a word descriptor in a range.
+   * @return the expected value of the target.
+   */
+  template <class Field>
+  static auto
+  GetOldValue(const RangeWordDescriptor &word)  //
+      -> Field
+  {
+    static_assert(std::is_same_v<Field, MwCASField>);
+    return word.GetOldValue();
+  }
+
+  /**
+   * @brief Prefetch the target words in the next cache line of a range to be written.
+   *
+   * @param pos the position of a word being installed or completed.
+   */
+  void
+  PrefetchRange(const size_t pos)
+  {
+    if (pos + kCopyWordNum < write_count_) {
+      __builtin_prefetch(GetRangeAddress(pos + kCopyWordNum), 1);
+    }
+  }
+
+  /**
+   * @brief Update/revert the target words of this finished descriptor.
+   *
+   */
+  void
+  CompleteWords()
+  {
+    const auto status = GetStatus();
+    if (layout_ == Layout::RANGE) {
+      for (size_t i = 0; i < write_count_; ++i) {
+        PrefetchRange(i);
+        GetRangeWord(i)->CompleteMwCAS(GetRangeAddress(i), status);
+      }
+      return;
+    }
+
+    auto *words = GetWords();
+    for (size_t i = 0; i < write_count_; i += words[i].GetWidth()) {
+      words[i].CompleteMwCAS(status);
+    }
+  }
+
+  /**
+   * @brief Validate compare-only targets after installing this descriptor.
+   *
+   * This function is called by the owner and helpers after they observe all the write
+   * targets occupied by this descriptor, and so the validated values are consistent with
+   * the locked targets. Since compare-only targets are not locked, this function does not
+   * help active descriptors in them. An active descriptor without compare-only targets
+   * does not depend on this one, and so its expected value is used.
+   *
+   * However, an active descriptor with compare-only targets may validate this one at
+   * the same time, and if both of them used expected values, both could succeed in
+   * spite of crossed updates (i.e., write skew). Thus, such a pair is resolved by their
+   * addresses: the lower descriptor aborts the higher one, and the higher one fails
+   * without identifying a mismatched target so that its owner retries the operation.
+   * Since the lowest descriptor is never aborted, some operation always makes progress.
+   *
+   * @param result an output for the details of this operation (only for an owner).
+   * @retval true if all the compare-only targets have expected values.
+   * @retval false otherwise.
+   */
+  auto
+  ValidateCompareTargets(MwCASResult *result)  //
+      -> bool
+  {
+    if (write_count_ == target_count_) return true;
+
+    // prevent the following loads from being reordered before installing descriptors
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    auto *words = GetWords();
+    for (size_t i = write_count_; i < target_count_; i += words[i].GetWidth()) {
+      const auto &word = words[i];
+      auto *addr = word.GetAddress();
+      const auto valid = (word.IsWide())
+                             ? ValidateCompareTarget(addr, word.GetWideOldValue(), result)
+                             : ValidateCompareTarget(addr, word.GetOldValue(), result);
+      if (!valid) return false;
+    }
+    return true;
+  }
+
+  /**
+   * @brief Validate a compare-only target after installing this descriptor.
+   *
+   * @tparam Field a class of target words (i.e., MwCASField or WideField).
+   * @param addr the address of a compare-only target.
+   * @param expected the expected value of the target.
+   * @param result an output for the details of this operation (only for an owner).
+   * @retval true if the target has the expected value.
+   * @retval false otherwise.
+   */
+  template <class Field>
+  auto
+  ValidateCompareTarget(  //
+      void *addr,
+      const Field &expected,
+      MwCASResult *result)  //
+      -> bool
+  {
+    while (true) {
+      // a finished descriptor must not abort others by a late validation
+      if (GetStatus() != Status::ACTIVE) return false;
+
+      DescriptorBase *blocker = nullptr;
+      const auto value = ReadWord<Field>(addr, this, blocker).second;
+      if (blocker != nullptr && blocker->write_count_ != blocker->target_count_) {
+        // the blocker may validate this descriptor, so only the lower one survives
+        if (std::less<DescriptorBase *>{}(blocker, this)) return false;
+        blocker->Abort();
+        continue;
+      }
+      if (value == expected) return true;
+
+      if (result != nullptr) {
+        *result = MwCASResult{addr, value};
+      }
+      return false;
+    }
+  }
+
+  /**
+   * @brief Fail this published descriptor on behalf of its owner.
+   *
+   * The owner cannot identify a mismatched target for an aborted descriptor, and so it
+   * retries the operation with a new descriptor.
+   *
+   */
+  void
+  Abort()
+  {
+    auto expected = Status::ACTIVE;
+    if (status_.compare_exchange_strong(expected, Status::FAILED, std::memory_order_acq_rel)) {
+      // this thread finalized the published descriptor, so mark it for reclamation
+      RetireForCleanUp(this);
+    }
+  }
+
+  /**
+   * @brief Register a finished descriptor with the list of the current thread.
+   *
+   * @param desc a finished descriptor.
+   */
+  static void
+  RetireForCleanUp(DescriptorBase *desc)
+  {
+    GetLocalState(desc->domain_id_).finished.RetireForCleanUp(desc);
+  }
+
+  /**
+   * @brief Finalize descriptors left by idle threads periodically until GC stops.
+   *
+   * @param domain_id the ID of a target domain.
+   */
+  static void
+  RunFinalizer(const size_t domain_id)
+  {
+    constexpr auto kInterval = std::chrono::microseconds{kFinalizeInterval};
+
+    auto &domain = GetDomain(domain_id);
+    std::unique_lock lock{domain.mtx};
+    while (!domain.cond.wait_for(lock, kInterval, [&] { return !domain.is_running; })) {
+      [[maybe_unused]] auto &&guard = domain.gc->CreateEpochGuard();
+      for (auto *state : domain.states) {
+        state->finished.FlushIfIdle();
+      }
+    }
+  }
+
+  /**
+   * @brief Search a target word that has an unexpected value after this MwCAS failed.
+   *
+   * @tparam ContentionManager a class to decide when to help active MwCAS operations
+   * @return the result containing the first mismatched word (if exist).
+   */
+  template <class ContentionManager>
+  auto
+  FindMismatchedWord()  //
+      -> MwCASResult
+  {
+    MwCASResult result{};
+    if (!HasExpectedValues<ReadPolicy::HELPING, ContentionManager>(0, &result)) return result;
+
+    // all the words may have been reverted to the expected values
+    return MwCASResult{nullptr, MwCASField{}};
+  }
+
+  /**
+   * @brief Read a value from a given memory address.
+   * \e NOTE: if a memory address is included in MwCAS target fields, it must be read via
+   * this function.
+   *
+   * Since a helper uses its own contention manager, threads with different contention
+   * managers can update the same words.
+   *
+   * @tparam kPolicy a policy for active MwCAS operations
+   * @tparam ContentionManager a class to decide when to help active MwCAS operations
+   * @param addr a target memory address to read
+   * @tparam Field a class of target words (i.e., MwCASField or WideField)
+   * @param addr a target memory address to read
+   * @param self a descriptor that calls this function (if exist)
+   * @return a pair of the raw word in the address and its logical value
+   */
+  template <ReadPolicy kPolicy = ReadPolicy::HELPING,
+            class ContentionManager = EagerHelping,
+            class Field = MwCASField>
+  static auto
+  ReadInternal(  //
+      void *addr,
+      DescriptorBase *self)  //
+      -> std::pair<Field, Field>
+  {
+    ContentionManager cm{};
+    while (true) {
+      DescriptorBase *blocker = nullptr;
+      auto &&words = ReadWord<Field>(addr, self, blocker);
+      if (blocker == nullptr) return words;
+      if constexpr (kPolicy == ReadPolicy::NON_HELPING) {
+        // compare-only targets may be changed after validation but before the status is
+        // set, and so finish the blocker unless this read is a pre-check of a MwCAS
+        if (self != nullptr || blocker->write_count_ == blocker->target_count_) return words;
+      }
+      if (cm.OnActiveDescriptor()) {
+        Statistics::Add(blocker->domain_id_, HELP);
+        blocker->template MwCASInternal<ContentionManager>();
+      }
+    }
+  }
+
+  /**
+   * @brief Read a word and its logical value from a given memory address once.
+   *
+   * If the word is occupied by an active descriptor of another thread, the logical
+   * value is the expected one of the descriptor. A double-width target is read by one
+   * atomic 16-byte load or CAS instruction, and so its two words are consistent.
+   *
+   * @tparam Field a class of target words (i.e., MwCASField or WideField)
+   * @param addr a target memory address to read
+   * @param self a descriptor that calls this function (if exist)
+   * @param blocker an output for an active descriptor of another thread (if exist)
+   * @return a pair of the raw word in the address and its logical value
+   */
+  template <class Field = MwCASField>
+  static auto
+  ReadWord(  //
+      void *addr,
+      DescriptorBase *self,
+      DescriptorBase *&blocker)  //
+      -> std::pair<Field, Field>
+  {
+    const auto target_word = LoadWord<Field>(addr);
+    if (!target_word.IsWordDescriptor()) return {target_word, target_word};
+
+    // found a word descriptor, which may belong to a descriptor of any capacity or a range
+    auto *parent = GetParent(target_word.template GetTargetData<void *>());
+    const auto parent_status = parent->GetStatus();
+    if (parent != self && parent_status == Status::ACTIVE) {
+      blocker = parent;
+    }
+    if constexpr (std::is_same_v<Field, WideField>) {
+      assert(parent->layout_ == Layout::WORDS);  // a range does not contain double-width targets
+      auto *word = target_word.template GetTargetData<WordDescriptor *>();
+      return {target_word, word->GetWideCurrentValue(parent_status)};
+    } else {
+      if (parent->layout_ == Layout::RANGE) {
+        auto *word = target_word.template GetTargetData<RangeWordDescriptor *>();
+        return {target_word, word->GetCurrentValue(parent_status)};
+      }
+      auto *word = target_word.template GetTargetData<WordDescriptor *>();
+      return {target_word, word->GetCurrentValue(parent_status)};
+    }
+  }
+
+  /**
+   * @brief Load a raw word from a given memory address.
+   *
+   * @tparam Field a class of target words (i.e., MwCASField or WideField)
+   * @param addr a target memory address to read
+   * @return the raw word in the address
+   */
+  template <class Field = MwCASField>
+  static auto
+  LoadWord(void *addr)  //
+      -> Field
+  {
+    if constexpr (std::is_same_v<Field, WideField>) {
+      return LoadWide(addr);
+    } else {
+      return static_cast<std::atomic<MwCASField> *>(addr)->load(std::memory_order_acquire);
+    }
+  }
+
+  /**
+   * @brief Read the values of targets by double collect until they are consistent.
+   *
+   * @tparam ContentionManager a class to decide when to help active MwCAS operations
+   * @tparam Ts classes of target fields
+   * @tparam kIds indices of targets
+   * @param domain_id the ID of a domain that counts retries.
+   * @param addrs target memory addresses to read
+   * @return a tuple of read values
+   */
+  template <class ContentionManager, class... Ts, size_t... kIds>
+  static auto
+  ReadSnapshotInternal(  //
+      const size_t domain_id,
+      const std::array<void *, sizeof...(Ts)> &addrs,
+      std::index_sequence<kIds...>)  //
+      -> std::tuple<Ts...>
+  {
+    while (true) {
+      // the first collect finishes active MwCAS operations on the targets
+      const std::tuple<std::pair<TargetField_t<Ts>, TargetField_t<Ts>>...> words{
+          ReadInternal<ReadPolicy::HELPING, ContentionManager, TargetField_t<Ts>>(addrs[kIds],
+                                                                                  nullptr)...};
+
+      // the second collect confirms that no target has been modified since the first one
+      if (((LoadWord<TargetField_t<Ts>>(addrs[kIds]) == std::get<kIds>(words).first) && ...)) {
+        return {std::get<kIds>(words).second.template GetTargetData<Ts>()...};
+      }
+      Statistics::Add(domain_id, OPERATION_RETRY);
+    }
+  }
+
+  /*################################################################################################
+   * Internal member variables
+   *##############################################################################################*/
+
+  /// a status of this AOPT descriptor
+  std::atomic<Status> status_{Status::ACTIVE};
+
+  /// the layout of this page (i.e., word descriptors, a range, or an extension of a range)
+  Layout layout_{Layout::WORDS};
+
+  /// the ID of a domain that this descriptor belongs to
+  uint16_t domain_id_{};
+
+  /// The number of registered MwCAS targets
+  uint16_t target_count_{0};
+
+  /// The number of targets to be updated (i.e., the others are compare-only targets)
+  uint16_t write_count_{0};
+};
+
+// word descriptors must follow a descriptor header
+static_assert(sizeof(DescriptorBase) == kDescriptorHeaderSize);
+
+// the number of targets must be represented by a descriptor header
+static_assert(kMwCASCapacity <= std::numeric_limits<uint16_t>::max());
+static_assert(kMaxRangeLength <= std::numeric_limits<uint16_t>::max());
+
+// a range descriptor must refer to all of its extension pages
+static_assert(kMaxRangeLength <= kRangeWordsPerPage * kMaxRangePageNum);
+
+}  // namespace dbgroup::atomic::aopt::component
+
+#endif  // MWCAS_AOPT_AOPT_COMPONENT_DESCRIPTOR_BASE_H_
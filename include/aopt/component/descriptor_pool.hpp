@@ -0,0 +1,448 @@
+/*
+ * Copyright 2021 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MWCAS_AOPT_AOPT_COMPONENT_DESCRIPTOR_POOL_H_
+#define MWCAS_AOPT_AOPT_COMPONENT_DESCRIPTOR_POOL_H_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "common.hpp"
+#include "numa_utility.hpp"
+
+namespace dbgroup::atomic::aopt::component
+{
+/**
+ * @brief A struct to report the usage of descriptor pools.
+ *
+ */
+struct PoolStatistics {
+  /// the number of descriptors requested from pools
+  size_t get_num{0};
+
+  /// the number of requests served by descriptors cached in pools
+  size_t hit_num{0};
+
+  /// the number of pages reused from garbage collection
+  size_t reuse_num{0};
+
+  /// the number of pages newly allocated (from the slabs of the current node if NUMA is
+  /// enabled)
+  size_t alloc_num{0};
+
+  /// the number of unused descriptors returned to pools
+  size_t release_num{0};
+
+  /// the number of pages pulled from the shared pools of NUMA nodes
+  size_t node_reuse_num{0};
+
+  /// the number of reclaimed pages passed to the shared pools of remote NUMA nodes (i.e., a
+  /// proxy for cross-node traffic of descriptors rather than measured remote accesses)
+  size_t remote_num{0};
+};
+
+/**
+ * @brief A struct to aggregate the usage of descriptor pools that share it.
+ *
+ */
+struct PoolCounters {
+  /**
+   * @return the current values of the counters.
+   */
+  [[nodiscard]] auto
+  Load() const  //
+      -> PoolStatistics
+  {
+    PoolStatistics stats{};
+    stats.get_num = get_num.load(std::memory_order_relaxed);
+    stats.hit_num = hit_num.load(std::memory_order_relaxed);
+    stats.reuse_num = reuse_num.load(std::memory_order_relaxed);
+    stats.alloc_num = alloc_num.load(std::memory_order_relaxed);
+    stats.release_num = release_num.load(std::memory_order_relaxed);
+    stats.node_reuse_num = node_reuse_num.load(std::memory_order_relaxed);
+    stats.remote_num = remote_num.load(std::memory_order_relaxed);
+    return stats;
+  }
+
+  /**
+   * @brief Clear all the counters.
+   *
+   */
+  void
+  Reset()
+  {
+    get_num.store(0, std::memory_order_relaxed);
+    hit_num.store(0, std::memory_order_relaxed);
+    reuse_num.store(0, std::memory_order_relaxed);
+    alloc_num.store(0, std::memory_order_relaxed);
+    release_num.store(0, std::memory_order_relaxed);
+    node_reuse_num.store(0, std::memory_order_relaxed);
+    remote_num.store(0, std::memory_order_relaxed);
+  }
+
+  /// the total number of requested descriptors
+  std::atomic_size_t get_num{0};
+
+  /// the total number of requests served by cached descriptors
+  std::atomic_size_t hit_num{0};
+
+  /// the total number of reused pages
+  std::atomic_size_t reuse_num{0};
+
+  /// the total number of allocated pages
+  std::atomic_size_t alloc_num{0};
+
+  /// the total number of released descriptors
+  std::atomic_size_t release_num{0};
+
+  /// the total number of pages pulled from the shared pools of nodes
+  std::atomic_size_t node_reuse_num{0};
+
+  /// the total number of reclaimed pages passed to remote nodes
+  std::atomic_size_t remote_num{0};
+};
+
+/**
+ * @brief A class to cache descriptor pages for each thread.
+ *
+ * A pool is assumed to be a thread-local object. If a pool becomes empty, it pulls
+ * reclaimed pages from garbage collection in bulk. If garbage collection has no pages
+ * to be reused, it pulls pages from a shared pool of the current NUMA node, which
+ * retains surplus pages of the other threads on the node, and then allocates a new page.
+ *
+ * If NUMA is enabled, new pages are carved out of slabs bound to the current node, and
+ * reclaimed pages on remote nodes are passed to the shared pools of their nodes instead
+ * of being cached. The node of a page is read from the header of its slab. Thus, each
+ * thread only uses pages on its own node. Since pages are released by FreeOnNode, a
+ * class of descriptors given to GC must release itself in the same way (see
+ * DescriptorPage). On a single-node host, a shared pool is only used to exchange
+ * surplus pages.
+ *
+ * Each pool reports its usage to given shared counters (e.g., the counters of a MwCAS
+ * domain). Since pages are plain memory, pools of any counters share the node pools.
+ *
+ * @tparam Descriptor a class of cached descriptors.
+ */
+template <class Descriptor>
+class alignas(kCacheLineSize) DescriptorPool
+{
+  // pages are carved out of slabs, and so each page must be aligned to its size
+  static_assert(sizeof(Descriptor) == alignof(Descriptor));
+
+ public:
+  /*################################################################################################
+   * Public constructors and assignment operators
+   *##############################################################################################*/
+
+  /**
+   * @brief Create an empty pool.
+   *
+   * @param counters shared counters to report the usage of this pool.
+   */
+  explicit DescriptorPool(PoolCounters &counters = GetDefaultCounters()) : counters_{&counters}
+  {
+  }
+
+  DescriptorPool(const DescriptorPool &) = delete;
+  DescriptorPool &operator=(const DescriptorPool &obj) = delete;
+  DescriptorPool(DescriptorPool &&) = delete;
+  DescriptorPool &operator=(DescriptorPool &&) = delete;
+
+  /*################################################################################################
+   * Public destructors
+   *##############################################################################################*/
+
+  /**
+   * @brief Destroy the pool and release cached pages.
+   *
+   */
+  ~DescriptorPool()
+  {
+    // other threads on the same node can reuse the cached pages
+    PushToNode(GetCurrentNUMANode(), pages_.data(), page_num_);
+    FlushStatistics();
+  }
+
+  /*################################################################################################
+   * Public getters
+   *##############################################################################################*/
+
+  /**
+   * @return the statistics aggregated from the pools with the default counters.
+   *
+   * Note that each thread reflects its counters only when it refills its pool or
+   * exits, and so the returned values may lag behind running threads.
+   */
+  static auto
+  GetStatistics()  //
+      -> PoolStatistics
+  {
+    return GetDefaultCounters().Load();
+  }
+
+  /*################################################################################################
+   * Public utility functions
+   *##############################################################################################*/
+
+  /**
+   * @brief Get a page for a new descriptor.
+   *
+   * @tparam GC a class of garbage collection.
+   * @param gc garbage collection that may retain reclaimed pages.
+   * @return a page to construct a descriptor.
+   */
+  template <class GC>
+  auto
+  Get(GC *gc)  //
+      -> void *
+  {
+    ++local_stats_.get_num;
+    if (page_num_ > 0) {
+      ++local_stats_.hit_num;
+      return pages_[--page_num_];
+    }
+
+    // pull reclaimed pages in bulk
+    std::array<void *, kRefillSize> reclaimed{};
+    size_t reclaimed_num = 0;
+    while (reclaimed_num < kRefillSize) {
+      auto *page = gc->template GetPageIfPossible<Descriptor>();
+      if (page == nullptr) break;
+      reclaimed[reclaimed_num++] = page;
+    }
+    local_stats_.reuse_num += reclaimed_num;
+
+    // keep only the pages on the current node
+    const auto node = GetCurrentNUMANode();
+    if (reclaimed_num > 0) {
+      KeepLocalPages(reclaimed.data(), reclaimed_num, node);
+    }
+    if (page_num_ == 0) {
+      PullFromNode(node);
+    }
+    FlushStatistics();
+    if (page_num_ > 0) return pages_[--page_num_];
+
+    // there are no reclaimed pages, so allocate a page on the current node
+    counters_->alloc_num.fetch_add(1, std::memory_order_relaxed);
+    return AllocateOnNode<sizeof(Descriptor)>();
+  }
+
+  /**
+   * @brief Return an unused descriptor to this pool.
+   *
+   * The given descriptor must not be visible to other threads.
+   *
+   * @param desc a descriptor to be reused.
+   */
+  void
+  Release(Descriptor *desc)
+  {
+    ++local_stats_.release_num;
+    desc->~Descriptor();
+    if (page_num_ == kDescriptorPoolCapacity) {
+      // shrink this pool in a batch to bound cached memory
+      PushToNode(GetCurrentNUMANode(), &(pages_[kRetainedSize]),
+                 kDescriptorPoolCapacity - kRetainedSize);
+      page_num_ = kRetainedSize;
+    }
+    pages_[page_num_++] = desc;
+  }
+
+ private:
+  /*################################################################################################
+   * Internal structs
+   *##############################################################################################*/
+
+  /**
+   * @brief A struct to share surplus pages among threads on the same NUMA node.
+   *
+   */
+  struct alignas(kCacheLineSize) NodePool {
+    ~NodePool()
+    {
+      for (auto *page : pages) {
+        Deallocate(page);
+      }
+    }
+
+    /// a mutex to protect shared pages
+    std::mutex mtx{};
+
+    /// shared pages
+    std::vector<void *> pages{};
+  };
+
+  /*################################################################################################
+   * Internal constants
+   *##############################################################################################*/
+
+  /// the number of pages to be pulled from garbage collection at once
+  static constexpr size_t kRefillSize = (kDescriptorPoolCapacity + 1) / 2;
+
+  /// the number of pages retained when a full pool is shrunk
+  static constexpr size_t kRetainedSize = kDescriptorPoolCapacity / 2;
+
+  /// the maximum number of pages shared in each NUMA node
+  static constexpr size_t kMaxNodePoolSize = 16 * kDescriptorPoolCapacity;
+
+  /*################################################################################################
+   * Internal utility functions
+   *##############################################################################################*/
+
+  /**
+   * @brief Release a page to the allocator of NUMA nodes.
+   *
+   * @param page a page to be released.
+   */
+  static void
+  Deallocate(void *page)
+  {
+    FreeOnNode<sizeof(Descriptor)>(page);
+  }
+
+  /**
+   * @return the counters shared by pools without specific counters.
+   */
+  static auto
+  GetDefaultCounters()  //
+      -> PoolCounters &
+  {
+    static PoolCounters counters{};
+    return counters;
+  }
+
+  /**
+   * @return the shared pools of all the NUMA nodes.
+   */
+  static auto
+  GetNodePools()  //
+      -> NodePool *
+  {
+    static const std::unique_ptr<NodePool[]> pools{new NodePool[GetNUMANodeNum()]};
+    return pools.get();
+  }
+
+  /**
+   * @brief Cache reclaimed pages on the current node and pass the others to their nodes.
+   *
+   * @param pages reclaimed pages.
+   * @param page_num the number of reclaimed pages.
+   * @param node the NUMA node of the current thread.
+   */
+  void
+  KeepLocalPages(  //
+      void **pages,
+      const size_t page_num,
+      const size_t node)
+  {
+    for (size_t i = 0; i < page_num; ++i) {
+      const auto page_node = GetNUMANodeOf(pages[i]);
+      if (page_node == node) {
+        pages_[page_num_++] = pages[i];
+      } else {
+        ++local_stats_.remote_num;
+        PushToNode(page_node, &(pages[i]), 1);
+      }
+    }
+  }
+
+  /**
+   * @brief Pull pages in bulk from the shared pool of a given node.
+   *
+   * @param node the NUMA node of the current thread.
+   */
+  void
+  PullFromNode(const size_t node)
+  {
+    auto &pool = GetNodePools()[node];
+    std::lock_guard guard{pool.mtx};
+    while (page_num_ < kRefillSize && !pool.pages.empty()) {
+      pages_[page_num_++] = pool.pages.back();
+      pool.pages.pop_back();
+    }
+    local_stats_.node_reuse_num += page_num_;
+  }
+
+  /**
+   * @brief Pass pages to the shared pool of a given node.
+   *
+   * If the shared pool is full, the remaining pages are released by FreeOnNode (i.e., to
+   * the slabs of their node on a multi-node host).
+   *
+   * @param node the NUMA node of the pages.
+   * @param pages the pages to be shared.
+   * @param page_num the number of the pages.
+   */
+  static void
+  PushToNode(  //
+      const size_t node,
+      void **pages,
+      const size_t page_num)
+  {
+    size_t shared_num = 0;
+    {
+      auto &pool = GetNodePools()[node];
+      std::lock_guard guard{pool.mtx};
+      shared_num = std::min(page_num, kMaxNodePoolSize - pool.pages.size());
+      pool.pages.insert(pool.pages.end(), pages, pages + shared_num);
+    }
+    for (size_t i = shared_num; i < page_num; ++i) {
+      Deallocate(pages[i]);
+    }
+  }
+
+  /**
+   * @brief Reflect the local counters on the global ones.
+   *
+   */
+  void
+  FlushStatistics()
+  {
+    counters_->get_num.fetch_add(local_stats_.get_num, std::memory_order_relaxed);
+    counters_->hit_num.fetch_add(local_stats_.hit_num, std::memory_order_relaxed);
+    counters_->reuse_num.fetch_add(local_stats_.reuse_num, std::memory_order_relaxed);
+    counters_->release_num.fetch_add(local_stats_.release_num, std::memory_order_relaxed);
+    counters_->node_reuse_num.fetch_add(local_stats_.node_reuse_num, std::memory_order_relaxed);
+    counters_->remote_num.fetch_add(local_stats_.remote_num, std::memory_order_relaxed);
+    local_stats_ = PoolStatistics{};
+  }
+
+  /*################################################################################################
+   * Internal member variables
+   *##############################################################################################*/
+
+  /// shared counters to report the usage of this pool
+  PoolCounters *counters_{nullptr};
+
+  /// cached pages
+  std::array<void *, kDescriptorPoolCapacity> pages_{};
+
+  /// the number of cached pages
+  size_t page_num_{0};
+
+  /// counters that have not been reflected on the global ones
+  PoolStatistics local_stats_{};
+};
+
+}  // namespace dbgroup::atomic::aopt::component
+
+#endif  // MWCAS_AOPT_AOPT_COMPONENT_DESCRIPTOR_POOL_H_
@@ -0,0 +1,149 @@
+/*
+ * Copyright 2021 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MWCAS_AOPT_AOPT_COMPONENT_MWCAS_RESULT_H_
+#define MWCAS_AOPT_AOPT_COMPONENT_MWCAS_RESULT_H_
+
+#include "mwcas_field.hpp"
+#include "wide_field.hpp"
+
+namespace dbgroup::atomic::aopt::component
+{
+/**
+ * @brief A class to represent the outcome of a MwCAS operation.
+ *
+ * If a MwCAS operation fails, this object retains a target address whose value was
+ * different from an expected one and the observed value. Since targets are sorted by
+ * their addresses before installation, a failed target is identified by its address
+ * instead of the order of registration. Callers can rebuild the next descriptor by
+ * using the observed value without reading the address again.
+ *
+ */
+class MwCASResult
+{
+ public:
+  /*################################################################################################
+   * Public constructors and assignment operators
+   *##############################################################################################*/
+
+  /**
+   * @brief Construct a result of a succeeded MwCAS operation.
+   *
+   */
+  constexpr MwCASResult() = default;
+
+  /**
+   * @brief Construct a result of a failed MwCAS operation.
+   *
+   * @param failed_addr a target address that had an unexpected value (if known).
+   * @param observed_val the observed value in the address.
+   */
+  constexpr MwCASResult(  //
+      void *failed_addr,
+      const MwCASField observed_val)
+      : success_{false}, failed_addr_{failed_addr}, observed_val_{observed_val, MwCASField{}}
+  {
+  }
+
+  /**
+   * @brief Construct a result of a MwCAS operation that failed at a double-width target.
+   *
+   * @param failed_addr a target address that had an unexpected value.
+   * @param observed_val the observed value in the address.
+   */
+  constexpr MwCASResult(  //
+      void *failed_addr,
+      const WideField &observed_val)
+      : success_{false}, failed_addr_{failed_addr}, observed_val_{observed_val}
+  {
+  }
+
+  constexpr MwCASResult(const MwCASResult &) = default;
+  constexpr MwCASResult &operator=(const MwCASResult &obj) = default;
+  constexpr MwCASResult(MwCASResult &&) = default;
+  constexpr MwCASResult &operator=(MwCASResult &&) = default;
+
+  /*################################################################################################
+   * Public destructors
+   *##############################################################################################*/
+
+  /**
+   * @brief Destroy the MwCASResult object.
+   *
+   */
+  ~MwCASResult() = default;
+
+  /*################################################################################################
+   * Public operators
+   *##############################################################################################*/
+
+  /**
+   * @retval true if a MwCAS operation succeeded.
+   * @retval false otherwise.
+   */
+  constexpr explicit operator bool() const { return success_; }
+
+  /*################################################################################################
+   * Public getters
+   *##############################################################################################*/
+
+  /**
+   * @return a target address that had an unexpected value.
+   *
+   * This function returns nullptr if a MwCAS operation succeeded or a failed target
+   * could not be identified (e.g., the target has been reverted to an expected value).
+   */
+  [[nodiscard]] constexpr auto
+  GetFailedAddress() const  //
+      -> void *
+  {
+    return failed_addr_;
+  }
+
+  /**
+   * @tparam T an expected class of a target.
+   * @return the observed value in a failed target address.
+   */
+  template <class T>
+  [[nodiscard]] auto
+  GetObservedValue() const  //
+      -> T
+  {
+    if constexpr (sizeof(T) == kWideWordSize) {
+      return observed_val_.GetTargetData<T>();
+    } else {
+      return observed_val_.lo.GetTargetData<T>();
+    }
+  }
+
+ private:
+  /*################################################################################################
+   * Internal member variables
+   *##############################################################################################*/
+
+  /// a flag to represent a MwCAS operation succeeded
+  bool success_{true};
+
+  /// a target address that had an unexpected value
+  void *failed_addr_{nullptr};
+
+  /// the observed value in a failed target address (only the first word is used if 8 bytes)
+  WideField observed_val_{};
+};
+
+}  // namespace dbgroup::atomic::aopt::component
+
+#endif  // MWCAS_AOPT_AOPT_COMPONENT_MWCAS_RESULT_H_
@@ -0,0 +1,249 @@
+/*
+ * Copyright 2021 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MWCAS_AOPT_AOPT_COMPONENT_NUMA_UTILITY_H_
+#define MWCAS_AOPT_AOPT_COMPONENT_NUMA_UTILITY_H_
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+
+#ifdef MWCAS_AOPT_USE_NUMA
+#include <numa.h>
+#include <numaif.h>
+#include <sched.h>
+#endif
+
+#include "common.hpp"
+
+namespace dbgroup::atomic::aopt::component
+{
+/*##################################################################################################
+ * Global constants
+ *################################################################################################*/
+
+/// The size and alignment of a slab, from which pages are carved on multi-node hosts.
+constexpr size_t kNUMASlabSize = 2UL * 1024 * 1024;
+
+/*##################################################################################################
+ * Global utility functions
+ *################################################################################################*/
+
+#ifdef MWCAS_AOPT_TEST_NUMA_NODE_NUM
+/**
+ * @brief Get the NUMA node that the current thread pretends to run on.
+ *
+ * Unit tests define MWCAS_AOPT_TEST_NUMA_NODE_NUM to run the multi-node paths on any
+ * host. Memory is not bound to nodes in this case.
+ *
+ * @return a reference to the node of the current thread.
+ */
+inline auto
+GetFakeNUMANode()  //
+    -> size_t &
+{
+  thread_local size_t node = 0;
+  return node;
+}
+#endif
+
+/**
+ * @return the number of NUMA nodes (one if NUMA is disabled or unavailable).
+ */
+inline auto
+GetNUMANodeNum()  //
+    -> size_t
+{
+#if defined(MWCAS_AOPT_TEST_NUMA_NODE_NUM)
+  return MWCAS_AOPT_TEST_NUMA_NODE_NUM;
+#elif defined(MWCAS_AOPT_USE_NUMA)
+  static const size_t node_num = (numa_available() < 0) ? 1 : numa_max_node() + 1;
+  return node_num;
+#else
+  return 1;
+#endif
+}
+
+/**
+ * @return the NUMA node of a CPU that runs the current thread.
+ */
+inline auto
+GetCurrentNUMANode()  //
+    -> size_t
+{
+#if defined(MWCAS_AOPT_TEST_NUMA_NODE_NUM)
+  return GetFakeNUMANode();
+#elif defined(MWCAS_AOPT_USE_NUMA)
+  if (GetNUMANodeNum() > 1) {
+    const auto cpu = sched_getcpu();
+    const auto node = (cpu < 0) ? -1 : numa_node_of_cpu(cpu);
+    if (node >= 0) return node;
+  }
+#endif
+  return 0;
+}
+
+/**
+ * @brief Get the NUMA node of a page allocated by AllocateOnNode.
+ *
+ * On a multi-node host, the node is recorded in the header of the slab that contains
+ * the page, and so this function does not need any system call.
+ *
+ * @param page an address in a target page.
+ * @return the NUMA node of the page (zero on a single-node host).
+ */
+inline auto
+GetNUMANodeOf(const void *page)  //
+    -> size_t
+{
+  if (GetNUMANodeNum() == 1) return 0;
+
+  constexpr auto kSlabMask = ~(kNUMASlabSize - 1);
+  return *reinterpret_cast<const size_t *>(  // NOLINT
+      reinterpret_cast<uintptr_t>(page) & kSlabMask);
+}
+
+/**
+ * @brief A struct to carve pages of one size out of the slabs of a NUMA node.
+ *
+ * @tparam kPageSize the size and alignment of pages.
+ */
+template <size_t kPageSize>
+struct alignas(kCacheLineSize) NUMASlabs {
+  // a page must contain the header of a slab and a link of released pages
+  static_assert(kPageSize >= sizeof(size_t) && kPageSize >= sizeof(void *));
+  static_assert(kNUMASlabSize % kPageSize == 0 && kNUMASlabSize / kPageSize > 1);
+
+  /**
+   * @return the slabs of all the NUMA nodes.
+   */
+  static auto
+  Get()  //
+      -> NUMASlabs *
+  {
+    // slabs are never released so that pages can be freed during static destruction
+    static auto *slabs = new NUMASlabs[GetNUMANodeNum()];
+    return slabs;
+  }
+
+  /**
+   * @brief Take a released page or carve a new page out of the current slab.
+   *
+   * @param node the NUMA node of this struct.
+   * @return a new page.
+   */
+  auto
+  Allocate(const size_t node)  //
+      -> void *
+  {
+    std::lock_guard guard{mtx};
+    if (free_pages != nullptr) {
+      auto *page = free_pages;
+      free_pages = *static_cast<void **>(page);
+      return page;
+    }
+
+    if (next == end) {
+      auto *slab = static_cast<std::byte *>(
+          ::operator new(kNUMASlabSize, std::align_val_t{kNUMASlabSize}));
+#ifdef MWCAS_AOPT_USE_NUMA
+      // bind the slab before its pages are touched (a failure only loses locality)
+      constexpr size_t kMaskBits = 8 * sizeof(unsigned long);  // NOLINT
+      if (node < kMaskBits) {
+        const unsigned long mask = 1UL << node;  // NOLINT
+        mbind(slab, kNUMASlabSize, MPOL_BIND, &mask, kMaskBits, MPOL_MF_MOVE);
+      }
+#endif
+      *reinterpret_cast<size_t *>(slab) = node;  // NOLINT
+      next = slab + kPageSize;                   // the first page is the header
+      end = slab + kNUMASlabSize;
+    }
+    auto *page = next;
+    next += kPageSize;
+    return page;
+  }
+
+  /**
+   * @brief Return a page to the slabs of this node.
+   *
+   * @param page a page carved out of the slabs of this node.
+   */
+  void
+  Free(void *page)
+  {
+    std::lock_guard guard{mtx};
+    *static_cast<void **>(page) = free_pages;
+    free_pages = page;
+  }
+
+  /// a mutex to protect slabs
+  std::mutex mtx{};
+
+  /// a list of released pages linked by their first words
+  void *free_pages{nullptr};
+
+  /// the next page to be carved out of the current slab
+  std::byte *next{nullptr};
+
+  /// the end of the current slab
+  std::byte *end{nullptr};
+};
+
+/**
+ * @brief Allocate a page on the NUMA node of the current thread.
+ *
+ * On a multi-node host, pages are carved out of 2 MiB slabs bound to each node, and the
+ * first page of each slab records its node (see GetNUMANodeOf). Thus, a new page does
+ * not need any system call except for allocating a slab. Pages must be released by
+ * FreeOnNode, which returns them to the slabs of their node.
+ *
+ * @tparam kPageSize the size and alignment of a page.
+ * @return an allocated page.
+ */
+template <size_t kPageSize>
+auto
+AllocateOnNode()  //
+    -> void *
+{
+  if (GetNUMANodeNum() > 1) {
+    const auto node = GetCurrentNUMANode();
+    return NUMASlabs<kPageSize>::Get()[node].Allocate(node);
+  }
+  return ::operator new(kPageSize, std::align_val_t{kPageSize});
+}
+
+/**
+ * @brief Release a page allocated by AllocateOnNode.
+ *
+ * @tparam kPageSize the size and alignment of a page.
+ * @param page a page to be released.
+ */
+template <size_t kPageSize>
+void
+FreeOnNode(void *page)
+{
+  if (GetNUMANodeNum() > 1) {
+    NUMASlabs<kPageSize>::Get()[GetNUMANodeOf(page)].Free(page);
+    return;
+  }
+  ::operator delete(page, std::align_val_t{kPageSize});
+}
+
+}  // namespace dbgroup::atomic::aopt::component
+
+#endif  // MWCAS_AOPT_AOPT_COMPONENT_NUMA_UTILITY_H_
@@ -0,0 +1,111 @@
+/*
+ * Copyright 2021 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MWCAS_AOPT_AOPT_COMPONENT_SIMD_UTILITY_H_
+#define MWCAS_AOPT_AOPT_COMPONENT_SIMD_UTILITY_H_
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) && (defined(__AVX2__) || defined(__SSE2__))
+#include <immintrin.h>
+#endif
+
+#include "common.hpp"
+
+namespace dbgroup::atomic::aopt::component
+{
+/*##################################################################################################
+ * Global constants
+ *################################################################################################*/
+
+/// The number of words copied by one call of CopyWords (i.e., a cache line).
+constexpr size_t kCopyWordNum = kCacheLineSize / kWordSize;
+
+/*##################################################################################################
+ * Global utility functions
+ *################################################################################################*/
+
+/**
+ * @brief Copy kCopyWordNum words and find the words that contain word descriptors.
+ *
+ * A descriptor flag is the most significant bit of a word, and so this function gathers
+ * the sign bits of vector lanes by AVX2 or SSE2 on x86-64 (a loop of relaxed atomic
+ * loads otherwise). The words are not a consistent snapshot, and a caller must issue an
+ * acquire fence before using the copied words to access other memory.
+ *
+ * Vector loads of words that other threads modify are data races in the C++ memory
+ * model, and so they are used only on x86-64, where the behavior is defined by the ISA.
+ * Since the source is aligned to a cache line, each vector load is aligned to its width,
+ * and so each 8-byte word in it is read by one aligned access, which is atomic on
+ * x86-64. In addition, each loaded vector is passed through an empty asm statement so
+ * that the compiler cannot load the source again (e.g., for a spilled register) and
+ * thus copy words that differ from the ones whose flags are checked.
+ *
+ * @param src the address of the first source word (aligned to a cache line).
+ * @param dest the address of the first destination word.
+ * @return a bit mask whose i-th bit is set if the i-th word contains a descriptor.
+ */
+inline auto
+CopyWords(  //
+    const void *src,
+    void *dest)  //
+    -> uint32_t
+{
+  static_assert(kCopyWordNum <= 32);
+  assert(reinterpret_cast<uintptr_t>(src) % kCacheLineSize == 0);  // NOLINT
+
+  uint32_t mask = 0;
+#if defined(__x86_64__) && defined(__AVX2__)
+  constexpr size_t kLaneNum = sizeof(__m256i) / kWordSize;
+  const auto *src_vec = static_cast<const __m256i *>(src);
+  auto *dest_vec = static_cast<__m256i *>(dest);
+  for (size_t i = 0; i < kCopyWordNum / kLaneNum; ++i) {
+    auto vec = _mm256_load_si256(src_vec + i);
+    asm("" : "+x"(vec));
+    _mm256_storeu_si256(dest_vec + i, vec);
+    const auto flags = static_cast<uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(vec)));
+    mask |= flags << (i * kLaneNum);
+  }
+#elif defined(__x86_64__) && defined(__SSE2__)
+  constexpr size_t kLaneNum = sizeof(__m128i) / kWordSize;
+  const auto *src_vec = static_cast<const __m128i *>(src);
+  auto *dest_vec = static_cast<__m128i *>(dest);
+  for (size_t i = 0; i < kCopyWordNum / kLaneNum; ++i) {
+    auto vec = _mm_load_si128(src_vec + i);
+    asm("" : "+x"(vec));
+    _mm_storeu_si128(dest_vec + i, vec);
+    const auto flags = static_cast<uint32_t>(_mm_movemask_pd(_mm_castsi128_pd(vec)));
+    mask |= flags << (i * kLaneNum);
+  }
+#else
+  constexpr auto kFlagShift = 8 * kWordSize - 1;
+  const auto *src_words = static_cast<const std::atomic<uint64_t> *>(src);
+  auto *dest_words = static_cast<uint64_t *>(dest);
+  for (size_t i = 0; i < kCopyWordNum; ++i) {
+    const auto word = src_words[i].load(std::memory_order_relaxed);
+    dest_words[i] = word;
+    mask |= static_cast<uint32_t>(word >> kFlagShift) << i;
+  }
+#endif
+  return mask;
+}
+
+}  // namespace dbgroup::atomic::aopt::component
+
+#endif  // MWCAS_AOPT_AOPT_COMPONENT_SIMD_UTILITY_H_
@@ -0,0 +1,326 @@
+/*
+ * Copyright 2021 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MWCAS_AOPT_AOPT_COMPONENT_STATISTICS_H_
+#define MWCAS_AOPT_AOPT_COMPONENT_STATISTICS_H_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+
+#include "common.hpp"
+
+namespace dbgroup::atomic::aopt::component
+{
+/*##################################################################################################
+ * Global enum and structs
+ *################################################################################################*/
+
+/**
+ * @brief An enumeration for representing events counted in hot paths.
+ *
+ */
+enum Counter : size_t
+{
+  MWCAS_SUCCESS = 0,
+  MWCAS_FAILURE,
+  PRE_VALIDATION_FAILURE,
+  UNPUBLISHED_FAILURE,
+  OPERATION_RETRY,
+  EMBED_FAILURE,
+  HELP,
+  MAX_HELP_DEPTH,
+  HELP_DEPTH_LIMIT,
+  FINALIZE,
+  FINALIZED_DESCRIPTOR,
+  MAX_FINALIZE_SIZE,
+  COUNTER_NUM
+};
+
+/**
+ * @brief A struct to report events in MwCAS operations.
+ *
+ */
+struct MwCASStatistics {
+  /// the number of succeeded MwCAS operations
+  size_t success_num{0};
+
+  /// the number of failed MwCAS operations
+  size_t failure_num{0};
+
+  /// the number of MwCAS operations that failed before installing descriptors
+  size_t pre_validation_failure_num{0};
+
+  /// the number of MwCAS operations that failed before publishing their descriptors
+  size_t unpublished_failure_num{0};
+
+  /// the number of times that a whole operation is attempted again (e.g., in MwCASUpdate)
+  size_t retry_num{0};
+
+  /// the number of failed attempts to embed a word descriptor
+  size_t embed_failure_num{0};
+
+  /// the number of times that other threads' MwCAS operations are helped
+  size_t help_num{0};
+
+  /// the maximum length of helping chains (i.e., nested descriptors helped at once)
+  size_t max_help_depth{0};
+
+  /// the number of blockers helped in place of descriptors at kMaxHelpDepth
+  size_t help_limit_num{0};
+
+  /// the number of batches to finalize finished descriptors
+  size_t finalize_num{0};
+
+  /// the number of finalized descriptors
+  size_t finalized_desc_num{0};
+
+  /// the maximum number of descriptors finalized in one batch
+  size_t max_finalize_size{0};
+};
+
+/**
+ * @brief A class to collect per-thread counters of MwCAS operations.
+ *
+ * Each thread owns a cache-aligned slot of counters for every MwCAS domain, and so
+ * counting events only requires plain stores. Slots are linked in a lock-free list and
+ * reused after their threads exit, so the aggregated values remain cumulative. If
+ * statistics are disabled, all the functions are compiled into no-ops.
+ *
+ */
+class Statistics
+{
+ public:
+  /*################################################################################################
+   * Public utility functions
+   *##############################################################################################*/
+
+  /**
+   * @brief Add a given value to a counter of the current thread.
+   *
+   * @param domain_id the ID of a domain that the event belongs to.
+   * @param counter a target counter.
+   * @param val a value to be added.
+   */
+  static void
+  Add(  //
+      const size_t domain_id,
+      const Counter counter,
+      const size_t val = 1)
+  {
+    if constexpr (kEnableStatistics) {
+      auto &cnt = GetLocalSlot().counters[domain_id][counter];
+      cnt.store(cnt.load(std::memory_order_relaxed) + val, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * @brief Update a counter of the current thread if a given value is larger.
+   *
+   * @param domain_id the ID of a domain that the event belongs to.
+   * @param counter a target counter.
+   * @param val a candidate of the maximum value.
+   */
+  static void
+  UpdateMax(  //
+      const size_t domain_id,
+      const Counter counter,
+      const size_t val)
+  {
+    if constexpr (kEnableStatistics) {
+      auto &cnt = GetLocalSlot().counters[domain_id][counter];
+      if (val > cnt.load(std::memory_order_relaxed)) {
+        cnt.store(val, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /**
+   * @param domain_id the ID of a target domain.
+   * @return the statistics of a given domain aggregated from all the threads.
+   *
+   * If statistics are disabled, all the values are zero.
+   */
+  static auto
+  Collect(const size_t domain_id)  //
+      -> MwCASStatistics
+  {
+    std::array<size_t, COUNTER_NUM> sum{};
+    if constexpr (kEnableStatistics) {
+      for (auto *slot = GetRegistry().head.load(std::memory_order_acquire);  //
+           slot != nullptr;                                                 //
+           slot = slot->next) {
+        for (size_t i = 0; i < COUNTER_NUM; ++i) {
+          const auto val = slot->counters[domain_id][i].load(std::memory_order_relaxed);
+          if (i == MAX_HELP_DEPTH || i == MAX_FINALIZE_SIZE) {
+            sum[i] = std::max(sum[i], val);
+          } else {
+            sum[i] += val;
+          }
+        }
+      }
+    }
+
+    MwCASStatistics stats{};
+    stats.success_num = sum[MWCAS_SUCCESS];
+    stats.failure_num = sum[MWCAS_FAILURE];
+    stats.pre_validation_failure_num = sum[PRE_VALIDATION_FAILURE];
+    stats.unpublished_failure_num = sum[UNPUBLISHED_FAILURE];
+    stats.retry_num = sum[OPERATION_RETRY];
+    stats.embed_failure_num = sum[EMBED_FAILURE];
+    stats.help_num = sum[HELP];
+    stats.max_help_depth = sum[MAX_HELP_DEPTH];
+    stats.help_limit_num = sum[HELP_DEPTH_LIMIT];
+    stats.finalize_num = sum[FINALIZE];
+    stats.finalized_desc_num = sum[FINALIZED_DESCRIPTOR];
+    stats.max_finalize_size = sum[MAX_FINALIZE_SIZE];
+    return stats;
+  }
+
+  /**
+   * @brief Clear the counters of a given domain in all the threads.
+   *
+   * This function is called before reusing the ID of a destroyed domain, and so no
+   * thread counts events of the domain concurrently.
+   *
+   * @param domain_id the ID of a target domain.
+   */
+  static void
+  Reset(const size_t domain_id)
+  {
+    if constexpr (kEnableStatistics) {
+      for (auto *slot = GetRegistry().head.load(std::memory_order_acquire);  //
+           slot != nullptr;                                                 //
+           slot = slot->next) {
+        for (auto &&cnt : slot->counters[domain_id]) {
+          cnt.store(0, std::memory_order_relaxed);
+        }
+      }
+    }
+  }
+
+ private:
+  /*################################################################################################
+   * Internal structs
+   *##############################################################################################*/
+
+  /**
+   * @brief A struct to hold counters of one thread.
+   *
+   */
+  struct alignas(kCacheLineSize) Slot {
+    /// counters of each domain written only by an owner thread
+    std::array<std::array<std::atomic_size_t, COUNTER_NUM>, kMaxDomainNum> counters{};
+
+    /// a flag to represent this slot is owned by a living thread
+    std::atomic_bool in_use{true};
+
+    /// the next slot in a registry
+    Slot *next{nullptr};
+  };
+
+  /**
+   * @brief A struct to hold all the slots, which are released at the end of a process.
+   *
+   */
+  struct Registry {
+    ~Registry()
+    {
+      auto *slot = head.load(std::memory_order_acquire);
+      while (slot != nullptr) {
+        auto *next = slot->next;
+        delete slot;
+        slot = next;
+      }
+    }
+
+    /// the head of registered slots
+    std::atomic<Slot *> head{nullptr};
+  };
+
+  /**
+   * @brief A class to bind a slot with the current thread.
+   *
+   */
+  class SlotHolder
+  {
+   public:
+    SlotHolder()
+    {
+      auto &registry = GetRegistry();
+
+      // reuse a slot released by an exited thread
+      for (auto *slot = registry.head.load(std::memory_order_acquire);  //
+           slot != nullptr;                                             //
+           slot = slot->next) {
+        auto expected = false;
+        if (slot->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+          slot_ = slot;
+          return;
+        }
+      }
+
+      // there are no free slots, so register a new one
+      slot_ = new Slot{};
+      slot_->next = registry.head.load(std::memory_order_relaxed);
+      while (!registry.head.compare_exchange_weak(slot_->next, slot_,  //
+                                                  std::memory_order_release,
+                                                  std::memory_order_relaxed)) {
+        // continue until the slot is registered
+      }
+    }
+
+    ~SlotHolder() { slot_->in_use.store(false, std::memory_order_release); }
+
+    SlotHolder(const SlotHolder &) = delete;
+    SlotHolder &operator=(const SlotHolder &obj) = delete;
+    SlotHolder(SlotHolder &&) = delete;
+    SlotHolder &operator=(SlotHolder &&) = delete;
+
+    /// a slot owned by the current thread
+    Slot *slot_{nullptr};
+  };
+
+  /*################################################################################################
+   * Internal utility functions
+   *##############################################################################################*/
+
+  /**
+   * @return the registry of all the slots.
+   */
+  static auto
+  GetRegistry()  //
+      -> Registry &
+  {
+    static Registry registry{};
+    return registry;
+  }
+
+  /**
+   * @return a slot of the current thread.
+   */
+  static auto
+  GetLocalSlot()  //
+      -> Slot &
+  {
+    thread_local SlotHolder holder{};
+    return *(holder.slot_);
+  }
+};
+
+}  // namespace dbgroup::atomic::aopt::component
+
+#endif  // MWCAS_AOPT_AOPT_COMPONENT_STATISTICS_H_
@@ -0,0 +1,243 @@
+/*
+ * Copyright 2021 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MWCAS_AOPT_AOPT_COMPONENT_WIDE_FIELD_H_
+#define MWCAS_AOPT_AOPT_COMPONENT_WIDE_FIELD_H_
+
+#include <cstring>
+#include <type_traits>
+
+#if defined(__x86_64__) && defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+#include "mwcas_field.hpp"
+
+namespace dbgroup::atomic::aopt::component
+{
+/*##################################################################################################
+ * Global constants
+ *################################################################################################*/
+
+/// The size of double-width MwCAS targets in bytes.
+constexpr size_t kWideWordSize = 2 * kWordSize;
+
+/*##################################################################################################
+ * Global utility functions
+ *################################################################################################*/
+
+/**
+ * @tparam T a class of MwCAS targets.
+ * @return the number of word descriptors used by a target of a given class.
+ */
+template <class T>
+constexpr auto
+GetWordNum()  //
+    -> size_t
+{
+  return (sizeof(T) == kWideWordSize) ? 2 : 1;
+}
+
+/**
+ * @param raw a raw word.
+ * @return a MwCAS field that has the same bit pattern as a given word.
+ */
+inline auto
+ToMwCASField(const uint64_t raw)  //
+    -> MwCASField
+{
+  MwCASField field{};
+  std::memcpy(static_cast<void *>(&field), &raw, kWordSize);
+  return field;
+}
+
+/**
+ * @param field a MwCAS field.
+ * @return a raw word that has the same bit pattern as a given field.
+ */
+inline auto
+ToRawWord(const MwCASField field)  //
+    -> uint64_t
+{
+  uint64_t raw{};
+  std::memcpy(&raw, &field, kWordSize);
+  return raw;
+}
+
+/**
+ * @brief A class to represent a double-width MwCAS target.
+ *
+ * The first word has the same format as MwCASField, and so it can contain an embedded
+ * word descriptor. Thus, the most significant bit of the first word of a target must not
+ * be used by applications. The second word can contain any 64-bit value, and it retains
+ * an expected value while a descriptor is embedded.
+ *
+ */
+struct alignas(kWideWordSize) WideField {
+  /*################################################################################################
+   * Public utility functions
+   *##############################################################################################*/
+
+  /**
+   * @tparam T a class of double-width targets.
+   * @param data target data.
+   * @return a double-width field that has the same bit pattern as given data.
+   */
+  template <class T>
+  static auto
+  From(const T data)  //
+      -> WideField
+  {
+    static_assert(sizeof(T) == kWideWordSize);
+    static_assert(std::is_trivially_copyable_v<T>);
+
+    WideField field{};
+    std::memcpy(static_cast<void *>(&field), &data, kWideWordSize);
+    return field;
+  }
+
+  /**
+   * @retval true if this field contains an embedded word descriptor.
+   * @retval false otherwise.
+   */
+  [[nodiscard]] constexpr auto
+  IsWordDescriptor() const  //
+      -> bool
+  {
+    return lo.IsWordDescriptor();
+  }
+
+  /**
+   * @tparam T an expected class of data.
+   * @return the data in this field (or an embedded descriptor if T is a pointer).
+   */
+  template <class T>
+  [[nodiscard]] auto
+  GetTargetData() const  //
+      -> T
+  {
+    if constexpr (std::is_pointer_v<T>) {
+      return lo.GetTargetData<T>();
+    } else {
+      static_assert(sizeof(T) == kWideWordSize);
+      T data{};
+      std::memcpy(static_cast<void *>(&data), this, kWideWordSize);
+      return data;
+    }
+  }
+
+  constexpr auto
+  operator==(const WideField &obj) const  //
+      -> bool
+  {
+    return lo == obj.lo && hi == obj.hi;
+  }
+
+  constexpr auto
+  operator!=(const WideField &obj) const  //
+      -> bool
+  {
+    return lo != obj.lo || hi != obj.hi;
+  }
+
+  /*################################################################################################
+   * Public member variables
+   *##############################################################################################*/
+
+  /// the first word, which may contain an embedded descriptor
+  MwCASField lo{};
+
+  /// the second word
+  MwCASField hi{};
+};
+
+/**
+ * @brief Perform a double-width CAS operation.
+ *
+ * On x86-64, this function uses cmpxchg16b directly so that it does not depend on
+ * libatomic or compiler options.
+ *
+ * @param addr a 16-byte aligned target address.
+ * @param expected an expected value, which is updated with the current value on failure.
+ * @param desired a desired value.
+ * @retval true if the target is updated.
+ * @retval false otherwise.
+ */
+inline auto
+CompareExchangeWide(  //
+    void *addr,
+    WideField &expected,
+    const WideField &desired)  //
+    -> bool
+{
+#if defined(__x86_64__)
+  auto exp_lo = ToRawWord(expected.lo);
+  auto exp_hi = ToRawWord(expected.hi);
+  bool success{};
+  asm volatile("lock cmpxchg16b %1"
+               : "=@ccz"(success), "+m"(*static_cast<unsigned __int128 *>(addr)),  //
+                 "+a"(exp_lo), "+d"(exp_hi)
+               : "b"(ToRawWord(desired.lo)), "c"(ToRawWord(desired.hi))
+               : "memory");
+  if (!success) {
+    expected.lo = ToMwCASField(exp_lo);
+    expected.hi = ToMwCASField(exp_hi);
+  }
+  return success;
+#else
+  return __atomic_compare_exchange(static_cast<WideField *>(addr), &expected, &desired, false,
+                                   __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+#endif
+}
+
+/**
+ * @brief Read a double-width word atomically.
+ *
+ * Processors with AVX guarantee that an aligned 16-byte load (i.e., vmovdqa) is
+ * atomic, and so this function first reads the target by a plain load if built with AVX
+ * (e.g., -mavx or -march=native). Only if the first word contains a descriptor, which
+ * will be helped by a CAS operation soon, it falls back to a CAS operation that writes
+ * back the read value if unchanged. Otherwise, since x86-64 does not guarantee atomicity
+ * of 16-byte loads, every read is performed by the CAS operation (i.e., lock cmpxchg16b)
+ * with zero as an expected value, which obtains the cache line exclusively as writes do.
+ *
+ * @param addr a 16-byte aligned target address.
+ * @return the current value in the address.
+ */
+inline auto
+LoadWide(void *addr)  //
+    -> WideField
+{
+  WideField current{};
+#if defined(__x86_64__) && defined(__AVX__)
+  __m128i val;
+  asm volatile("vmovdqa %1, %0"
+               : "=x"(val)
+               : "m"(*static_cast<const __m128i *>(addr))
+               : "memory");
+  std::memcpy(static_cast<void *>(&current), &val, kWideWordSize);
+  if (!current.lo.IsWordDescriptor()) return current;
+#endif
+  CompareExchangeWide(addr, current, current);
+  return current;
+}
+
+// double-width targets must be updated by one CAS instruction
+static_assert(sizeof(WideField) == kWideWordSize);
+
+}  // namespace dbgroup::atomic::aopt::component
+
+#endif  // MWCAS_AOPT_AOPT_COMPONENT_WIDE_FIELD_H_
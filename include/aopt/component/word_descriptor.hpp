@@ -18,14 +18,21 @@
 #define MWCAS_AOPT_AOPT_COMPONENT_WORD_DESCRIPTOR_H_
 
 #include <atomic>
+#include <cstdint>
 
 #include "mwcas_field.hpp"
+#include "wide_field.hpp"
 
 namespace dbgroup::atomic::aopt::component
 {
 /**
  * @brief A class to represent a word descriptor.
  *
+ * A double-width target is represented by two consecutive word descriptors: the first
+ * one (i.e., a head) has the target address and the first words of old/new values, and
+ * the second one (i.e., a tail) has the address of the second word and its old/new
+ * values. A descriptor is embedded only into the first word of a double-width target.
+ *
  */
 class WordDescriptor
 {
@@ -47,18 +54,17 @@ class WordDescriptor
    * @param addr a target memory address.
    * @param old_val an expected value of the target address.
    * @param new_val an desired value of the target address.
-   * @param parent_aopt an AOPT descriptor that has this object.
+   * @param is_wide_head a flag to represent the head of a double-width target.
    */
   template <class T>
-  constexpr WordDescriptor(  //
+  WordDescriptor(  //
       void *addr,
       const T old_val,
       const T new_val,
-      void *parent_aopt)
-      : addr_{static_cast<std::atomic<MwCASField> *>(addr)},
+      const bool is_wide_head = false)
+      : addr_{reinterpret_cast<uintptr_t>(addr) | (is_wide_head ? kWideFlag : 0UL)},
         old_val_{old_val},
-        new_val_{new_val},
-        parent_{parent_aopt}
+        new_val_{new_val}
   {
   }
 
@@ -88,7 +94,28 @@ class WordDescriptor
   GetAddress() const  //
       -> void *
   {
-    return addr_;
+    return reinterpret_cast<void *>(addr_ & ~kWideFlag);  // NOLINT
+  }
+
+  /**
+   * @retval true if this is the head of a double-width target.
+   * @retval false otherwise.
+   */
+  [[nodiscard]] constexpr auto
+  IsWide() const  //
+      -> bool
+  {
+    return (addr_ & kWideFlag) != 0;
+  }
+
+  /**
+   * @return the number of word descriptors used by this target.
+   */
+  [[nodiscard]] constexpr auto
+  GetWidth() const  //
+      -> size_t
+  {
+    return IsWide() ? 2 : 1;
   }
 
   /**
@@ -115,13 +142,25 @@ class WordDescriptor
   }
 
   /**
-   * @return AOPTDescriptor*: the address of the parent AOPT descriptor.
+   * @return the expected value of a double-width target (only for a head).
    */
   [[nodiscard]] auto
-  GetParent() const  //
-      -> void *
+  GetWideOldValue() const  //
+      -> WideField
   {
-    return parent_;
+    return {old_val_, GetTail()->old_val_};
+  }
+
+  /**
+   * @param status the current status of the parent AOPT descriptor.
+   * @return the current value of a double-width target (only for a head).
+   */
+  [[nodiscard]] auto
+  GetWideCurrentValue(const Status status) const  //
+      -> WideField
+  {
+    return (status == SUCCESSFUL) ? WideField{new_val_, GetTail()->new_val_}
+                                  : WideField{old_val_, GetTail()->old_val_};
   }
 
   /*################################################################################################
@@ -142,8 +181,48 @@ class WordDescriptor
     const MwCASField desc{this, true};
 
     MwCASField expected = content;
-    addr_->compare_exchange_strong(expected, desc,  //
-                                   std::memory_order_release, std::memory_order_relaxed);
+    GetTarget()->compare_exchange_strong(expected, desc,  //
+                                         std::memory_order_release, std::memory_order_relaxed);
+
+    return expected == content;
+  }
+
+  /**
+   * @brief Embed a descriptor into a double-width target (only for a head).
+   *
+   * The second word of the target is set to its expected value during embedding. Note
+   * that a given content may retain a stale second word if it contains a finished
+   * descriptor, and so it cannot be reused as the second word.
+   *
+   * @param content a current value in the target address.
+   * @retval true if the descriptor address is successfully embedded.
+   * @retval false otherwise.
+   */
+  auto
+  EmbedWideDescriptor(const WideField &content)  //
+      -> bool
+  {
+    auto expected = content;
+    const WideField desired{MwCASField{this, true}, GetTail()->old_val_};
+    return CompareExchangeWide(GetAddress(), expected, desired);
+  }
+
+  /**
+   * @brief Update a value of this target address without embedding a descriptor.
+   *
+   * This function can be used only if this word is the sole target of MwCAS.
+   *
+   * @param content a current word in the target address.
+   * @retval true if the desired value is successfully written.
+   * @retval false otherwise.
+   */
+  auto
+  UpdateDirectly(const MwCASField content)  //
+      -> bool
+  {
+    MwCASField expected = content;
+    GetTarget()->compare_exchange_strong(expected, new_val_,  //
+                                         std::memory_order_release, std::memory_order_relaxed);
 
     return expected == content;
   }
@@ -157,30 +236,201 @@ class WordDescriptor
   CompleteMwCAS(const Status status)
   {
     const MwCASField desc{this, true};
-    const MwCASField desired = (status == SUCCESSFUL) ? new_val_ : old_val_;
+    if (IsWide()) {
+      WideField expected{desc, GetTail()->old_val_};
+      CompareExchangeWide(GetAddress(), expected, GetWideCurrentValue(status));
+      return;
+    }
 
+    const MwCASField desired = (status == SUCCESSFUL) ? new_val_ : old_val_;
     MwCASField expected = desc;
-    addr_->compare_exchange_strong(expected, desired, std::memory_order_relaxed);
+    GetTarget()->compare_exchange_strong(expected, desired,  //
+                                         std::memory_order_release, std::memory_order_relaxed);
   }
 
  private:
+  /*################################################################################################
+   * Internal constants
+   *##############################################################################################*/
+
+  /// a flag embedded in a target address to represent the head of a double-width target
+  static constexpr uintptr_t kWideFlag = 1UL;
+
+  /*################################################################################################
+   * Internal utility functions
+   *##############################################################################################*/
+
+  /**
+   * @return the target word as an atomic object.
+   */
+  [[nodiscard]] auto
+  GetTarget() const  //
+      -> std::atomic<MwCASField> *
+  {
+    return static_cast<std::atomic<MwCASField> *>(GetAddress());
+  }
+
+  /**
+   * @return the tail of a double-width target (only for a head).
+   */
+  [[nodiscard]] auto
+  GetTail() const  //
+      -> const WordDescriptor *
+  {
+    return this + 1;
+  }
+
   /*################################################################################################
    * Internal member variables
    *##############################################################################################*/
 
-  /// A target memory address
-  std::atomic<MwCASField> *addr_{};
+  /// A target memory address with a flag for double-width targets
+  uintptr_t addr_{};
 
   /// An expected value of a target field
   MwCASField old_val_{};
 
   /// An inserting value into a target field
   MwCASField new_val_{};
+};
+
+// word descriptors do not retain their parents to reduce cache lines of descriptors
+static_assert(sizeof(WordDescriptor) == 3 * kWordSize);
+
+/**
+ * @brief A class to represent a word descriptor in a range of contiguous targets.
+ *
+ * Since the address of each target is derived from the base address of its range and
+ * the position of this descriptor, this class only retains old/new values.
+ *
+ */
+class RangeWordDescriptor
+{
+ public:
+  /*################################################################################################
+   * Public constructors and assignment operators
+   *##############################################################################################*/
+
+  /**
+   * @brief Construct an empty word descriptor.
+   *
+   */
+  constexpr RangeWordDescriptor() = default;
+
+  /**
+   * @brief Construct a new word descriptor based on given values.
+   *
+   * @tparam T a class of MwCAS targets.
+   * @param old_val an expected value of a target address.
+   * @param new_val an desired value of a target address.
+   */
+  template <class T>
+  RangeWordDescriptor(  //
+      const T old_val,
+      const T new_val)
+      : old_val_{old_val}, new_val_{new_val}
+  {
+  }
+
+  constexpr RangeWordDescriptor(const RangeWordDescriptor &) = default;
+  constexpr RangeWordDescriptor &operator=(const RangeWordDescriptor &obj) = default;
+  constexpr RangeWordDescriptor(RangeWordDescriptor &&) = default;
+  constexpr RangeWordDescriptor &operator=(RangeWordDescriptor &&) = default;
+
+  /*################################################################################################
+   * Public destructor
+   *##############################################################################################*/
+
+  /**
+   * @brief Destroy the RangeWordDescriptor object.
+   *
+   */
+  ~RangeWordDescriptor() = default;
 
-  /// An address of the corresponding AOPT descriptor
-  void *parent_{};
+  /*################################################################################################
+   * Public getters/setters
+   *##############################################################################################*/
+
+  /**
+   * @return MwCASField: the expected value of this descriptor.
+   */
+  [[nodiscard]] auto
+  GetOldValue() const  //
+      -> MwCASField
+  {
+    return old_val_;
+  }
+
+  /**
+   * @param status the current status of the parent AOPT descriptor.
+   * @return MwCASField: the current value in the target address.
+   */
+  [[nodiscard]] auto
+  GetCurrentValue(const Status status) const  //
+      -> MwCASField
+  {
+    return (status == SUCCESSFUL) ? new_val_ : old_val_;
+  }
+
+  /*################################################################################################
+   * Public utility functions
+   *##############################################################################################*/
+
+  /**
+   * @brief Embed a descriptor into a given target address.
+   *
+   * @param addr the target address of this descriptor.
+   * @param content a current word in the target address.
+   * @retval true if the descriptor address is successfully embedded.
+   * @retval false otherwise.
+   */
+  auto
+  EmbedDescriptor(  //
+      void *addr,
+      const MwCASField content)  //
+      -> bool
+  {
+    const MwCASField desc{this, true};
+
+    MwCASField expected = content;
+    static_cast<std::atomic<MwCASField> *>(addr)->compare_exchange_strong(
+        expected, desc, std::memory_order_release, std::memory_order_relaxed);
+
+    return expected == content;
+  }
+
+  /**
+   * @brief Update/revert a value of a given target address.
+   *
+   * @param addr the target address of this descriptor.
+   * @param status the current status of the parent AOPT descriptor.
+   */
+  void
+  CompleteMwCAS(  //
+      void *addr,
+      const Status status)
+  {
+    const MwCASField desc{this, true};
+    MwCASField expected = desc;
+    static_cast<std::atomic<MwCASField> *>(addr)->compare_exchange_strong(
+        expected, GetCurrentValue(status), std::memory_order_release, std::memory_order_relaxed);
+  }
+
+ private:
+  /*################################################################################################
+   * Internal member variables
+   *##############################################################################################*/
+
+  /// An expected value of a target field
+  MwCASField old_val_{};
+
+  /// An inserting value into a target field
+  MwCASField new_val_{};
 };
 
+// each word in a range needs only two thirds of a normal word descriptor
+static_assert(sizeof(RangeWordDescriptor) == 2 * kWordSize);
+
 }  // namespace dbgroup::atomic::aopt::component
 
 #endif  // MWCAS_AOPT_AOPT_COMPONENT_WORD_DESCRIPTOR_H_
@@ -0,0 +1,226 @@
+/*
+ * Copyright 2021 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MWCAS_AOPT_AOPT_CONTENTION_MANAGER_H_
+#define MWCAS_AOPT_AOPT_CONTENTION_MANAGER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+namespace dbgroup::atomic::aopt
+{
+/*##################################################################################################
+ * Internal utilities for contention managers
+ *################################################################################################*/
+
+namespace component
+{
+/**
+ * @brief Spin without writing shared memory.
+ *
+ * @param loop_num the number of iterations to wait.
+ */
+inline void
+SpinWait(const size_t loop_num)
+{
+  for (size_t i = 0; i < loop_num; ++i) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#else
+    std::this_thread::yield();
+#endif
+  }
+}
+
+/**
+ * @return a pseudo random number generated by a per-thread xorshift generator.
+ */
+inline auto
+GetRandomNumber()  //
+    -> uint64_t
+{
+  thread_local uint64_t state = reinterpret_cast<uint64_t>(&state) | 1UL;
+  state ^= state << 13UL;
+  state ^= state >> 7UL;
+  state ^= state << 17UL;
+  return state;
+}
+
+}  // namespace component
+
+/*##################################################################################################
+ * Contention managers
+ *################################################################################################*/
+
+/**
+ * @brief A contention manager to help active MwCAS operations immediately.
+ *
+ * This is the behavior of the original AOPT algorithm. A contention manager is
+ * constructed for each read/MwCAS operation and decides what to do when the operation
+ * finds an active descriptor of another thread (OnActiveDescriptor) or fails to embed its
+ * own descriptor (OnEmbedFailure).
+ *
+ */
+class EagerHelping
+{
+ public:
+  /**
+   * @retval true to help a found active descriptor.
+   * @retval false to read its target word again.
+   */
+  static constexpr auto
+  OnActiveDescriptor()  //
+      -> bool
+  {
+    return true;
+  }
+
+  /**
+   * @brief Do nothing before reading a target word again.
+   *
+   */
+  static constexpr void
+  OnEmbedFailure()
+  {
+  }
+};
+
+/**
+ * @brief A contention manager to wait for active MwCAS operations with exponential
+ * backoff before helping them.
+ *
+ * Since an owner thread is likely to finish its MwCAS operation during backoff, this
+ * manager avoids many threads performing the same MwCAS operation at once. If a target
+ * word is still occupied after the maximum backoff, this manager helps the operation.
+ *
+ * @tparam kMinWait the number of spins for the first backoff.
+ * @tparam kMaxWait the maximum number of spins for each backoff.
+ */
+template <size_t kMinWait = 16, size_t kMaxWait = 1024>
+class ExponentialBackoff
+{
+  static_assert(0 < kMinWait && kMinWait <= kMaxWait);
+
+ public:
+  /**
+   * @retval true to help a found active descriptor.
+   * @retval false to read its target word again after backoff.
+   */
+  auto
+  OnActiveDescriptor()  //
+      -> bool
+  {
+    if (wait_ > kMaxWait) {
+      // the descriptor seems to be blocked, so help it
+      wait_ = kMinWait;
+      return true;
+    }
+
+    Backoff();
+    return false;
+  }
+
+  /**
+   * @brief Wait with exponential backoff before reading a target word again.
+   *
+   */
+  void
+  OnEmbedFailure()
+  {
+    Backoff();
+    if (wait_ > kMaxWait) {
+      wait_ = kMaxWait;
+    }
+  }
+
+ private:
+  /**
+   * @brief Wait and double the time of the next backoff.
+   *
+   */
+  void
+  Backoff()
+  {
+    component::SpinWait(wait_);
+    wait_ *= 2;
+  }
+
+  /// the number of spins for the next backoff
+  size_t wait_{kMinWait};
+};
+
+/**
+ * @brief A contention manager to wait for a random time before helping active MwCAS
+ * operations.
+ *
+ * Randomized waiting spreads out threads that find the same active descriptor, and so
+ * only a few of them help it if its owner is delayed.
+ *
+ * @tparam kMaxWait the maximum number of spins for each wait.
+ */
+template <size_t kMaxWait = 1024>
+class RandomizedHelping
+{
+  static_assert(kMaxWait > 0);
+
+ public:
+  /**
+   * @retval true to help a found active descriptor.
+   * @retval false to read its target word again after random waiting.
+   */
+  auto
+  OnActiveDescriptor()  //
+      -> bool
+  {
+    if (has_waited_) {
+      has_waited_ = false;
+      return true;
+    }
+
+    RandomWait();
+    has_waited_ = true;
+    return false;
+  }
+
+  /**
+   * @brief Wait for a random time before reading a target word again.
+   *
+   */
+  static void
+  OnEmbedFailure()
+  {
+    RandomWait();
+  }
+
+ private:
+  /**
+   * @brief Wait for a random time up to kMaxWait spins.
+   *
+   */
+  static void
+  RandomWait()
+  {
+    component::SpinWait(component::GetRandomNumber() % kMaxWait + 1);
+  }
+
+  /// a flag to represent this thread has waited for an active descriptor
+  bool has_waited_{false};
+};
+
+}  // namespace dbgroup::atomic::aopt
+
+#endif  // MWCAS_AOPT_AOPT_CONTENTION_MANAGER_H_
@@ -0,0 +1,527 @@
+/*
+ * Copyright 2021 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MWCAS_AOPT_AOPT_MWCAS_DOMAIN_H_
+#define MWCAS_AOPT_AOPT_MWCAS_DOMAIN_H_
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+
+#include "aopt_descriptor.hpp"
+#include "aopt_range_descriptor.hpp"
+#include "contention_manager.hpp"
+
+namespace dbgroup::atomic::aopt
+{
+/**
+ * @brief A class to manage an independent set of AOPT descriptors.
+ *
+ * Each domain owns its GC, per-thread descriptor pools, finished descriptors, and
+ * statistics, and so a long-lived session in one domain does not delay reclamation in
+ * the others. Descriptors created by a domain are recycled and retired into it.
+ *
+ * Target words updated via a domain must be read and updated only via the same domain
+ * because its epochs protect only its own descriptors. Since retained descriptors are
+ * finalized when a domain is destroyed, a domain must be destroyed after all the
+ * threads stop using it and before its target words are released. Static functions of
+ * AOPTDescriptor (e.g., StartGC and GetDescriptor) use the default domain, which is
+ * not managed by this class.
+ *
+ */
+class MwCASDomain
+{
+  using DescriptorBase = component::DescriptorBase;
+
+ public:
+  /*################################################################################################
+   * Public type aliases
+   *##############################################################################################*/
+
+  using Session = DescriptorBase::Session;
+  using PoolStatistics = component::PoolStatistics;
+  using MwCASStatistics = component::MwCASStatistics;
+
+  /*################################################################################################
+   * Public constructors and assignment operators
+   *##############################################################################################*/
+
+  /**
+   * @brief Create a new domain and start its GC.
+   *
+   * @param gc_interval interval for GC in microseconds.
+   * @param gc_thread_num the number of worker threads to release garbages.
+   * @throws std::runtime_error if kMaxDomainNum - 1 domains already exist.
+   */
+  explicit MwCASDomain(  //
+      const size_t gc_interval = 100000,
+      const size_t gc_thread_num = 1)
+      : domain_id_{DescriptorBase::CreateDomain(gc_interval, gc_thread_num)}
+  {
+    if (domain_id_ >= kMaxDomainNum) {
+      throw std::runtime_error{"the number of MwCAS domains exceeds kMaxDomainNum"};
+    }
+  }
+
+  MwCASDomain(const MwCASDomain &) = delete;
+  MwCASDomain &operator=(const MwCASDomain &obj) = delete;
+  MwCASDomain(MwCASDomain &&) = delete;
+  MwCASDomain &operator=(MwCASDomain &&) = delete;
+
+  /*################################################################################################
+   * Public destructors
+   *##############################################################################################*/
+
+  /**
+   * @brief Finalize retained descriptors and stop the GC of this domain.
+   *
+   */
+  ~MwCASDomain() { DescriptorBase::DestroyDomain(domain_id_); }
+
+  /*################################################################################################
+   * Public getters
+   *##############################################################################################*/
+
+  /**
+   * @return the usage of per-thread descriptor pools in this domain.
+   */
+  [[nodiscard]] auto
+  GetPoolStatistics() const  //
+      -> PoolStatistics
+  {
+    return DescriptorBase::GetPoolStatistics(domain_id_);
+  }
+
+  /**
+   * @return events in MwCAS operations of this domain aggregated from all the threads.
+   *
+   * Note that the values are always zero unless MWCAS_AOPT_ENABLE_STATISTICS is defined.
+   */
+  [[nodiscard]] auto
+  GetStatistics() const  //
+      -> MwCASStatistics
+  {
+    return DescriptorBase::GetStatistics(domain_id_);
+  }
+
+  /*################################################################################################
+   * Public utility functions
+   *##############################################################################################*/
+
+  /**
+   * @tparam kCapacity the maximum number of target words of a descriptor.
+   * @tparam ContentionManager a class to decide when to help active MwCAS operations.
+   * @return a new MwCAS descriptor in this domain.
+   */
+  template <size_t kCapacity = kMwCASCapacity, class ContentionManager = EagerHelping>
+  [[nodiscard]] auto
+  GetDescriptor() const  //
+      -> AOPTDescriptor<kCapacity, ContentionManager> *
+  {
+    return AOPTDescriptor<kCapacity, ContentionManager>::GetDescriptor(domain_id_);
+  }
+
+  /**
+   * @tparam ContentionManager a class to decide when to help active MwCAS operations.
+   * @return a new range descriptor in this domain.
+   */
+  template <class ContentionManager = EagerHelping>
+  [[nodiscard]] auto
+  GetRangeDescriptor() const  //
+      -> AOPTRangeDescriptor<ContentionManager> *
+  {
+    return AOPTRangeDescriptor<ContentionManager>::GetDescriptor(domain_id_);
+  }
+
+  /**
+   * @brief Perform a MwCAS operation on targets known at compile time in this domain.
+   *
+   * @tparam ContentionManager a class to decide when to help active MwCAS operations
+   * @tparam Ts classes of targets
+   * @param targets MwCAS targets with distinct addresses
+   * @retval true if a MwCAS operation succeeds.
+   * @retval false otherwise (including duplicate target addresses).
+   */
+  template <class ContentionManager = EagerHelping, class... Ts>
+  auto
+  MwCAS(const MwCASTarget<Ts> &...targets) const  //
+      -> bool
+  {
+    constexpr auto kWordNum = (component::GetWordNum<Ts>() + ...);
+    auto *desc = GetDescriptor<kWordNum, ContentionManager>();
+    if (!desc->SetMwCASTargets(targets...)) {
+      desc->Discard();
+      return false;
+    }
+    return desc->MwCAS();
+  }
+
+  /**
+   * @brief Perform a MwCAS operation on targets known at compile time in a given session.
+   *
+   * @tparam ContentionManager a class to decide when to help active MwCAS operations
+   * @tparam Ts classes of targets
+   * @param session a session created by this domain
+   * @param targets MwCAS targets with distinct addresses
+   * @retval true if a MwCAS operation succeeds.
+   * @retval false otherwise (including duplicate target addresses).
+   */
+  template <class ContentionManager = EagerHelping, class... Ts>
+  auto
+  MwCAS(  //
+      const Session &session,
+      const MwCASTarget<Ts> &...targets) const  //
+      -> bool
+  {
+    constexpr auto kWordNum = (component::GetWordNum<Ts>() + ...);
+    auto *desc = GetDescriptor<kWordNum, ContentionManager>();
+    if (!desc->SetMwCASTargets(targets...)) {
+      desc->Discard();
+      return false;
+    }
+    return desc->MwCAS(session);
+  }
+
+  /**
+   * @brief Perform a MwCAS operation in a given session and report a mismatched target.
+   *
+   * @tparam ContentionManager a class to decide when to help active MwCAS operations
+   * @tparam Ts classes of targets
+   * @param session a session created by this domain
+   * @param result an output for a mismatched target and its observed value.
+   * @param targets MwCAS targets with distinct addresses
+   * @retval true if a MwCAS operation succeeds.
+   * @retval false otherwise (including duplicate target addresses).
+   */
+  template <class ContentionManager = EagerHelping, class... Ts>
+  auto
+  MwCAS(  //
+      const Session &session,
+      component::MwCASResult &result,
+      const MwCASTarget<Ts> &...targets) const  //
+      -> bool
+  {
+    constexpr auto kWordNum = (component::GetWordNum<Ts>() + ...);
+    auto *desc = GetDescriptor<kWordNum, ContentionManager>();
+    if (!desc->SetMwCASTargets(targets...)) {
+      desc->Discard();
+      result = component::MwCASResult{nullptr, component::MwCASField{}};
+      return false;
+    }
+    return desc->MwCAS(session, result);
+  }
+
+  /**
+   * @brief Update a target only if a control word has an expected value in this domain.
+   *
+   * @tparam ContentionManager a class to decide when to help active MwCAS operations
+   * @tparam C a class of a control word
+   * @tparam T a class of a target
+   * @param control a control word and its expected value
+   * @param target a MwCAS target to be updated
+   * @retval true if an RDCSS operation succeeds.
+   * @retval false otherwise (including a target that overlaps the control word).
+   */
+  template <class ContentionManager = EagerHelping, class C, class T>
+  auto
+  RDCSS(  //
+      const CompareTarget<C> &control,
+      const MwCASTarget<T> &target) const  //
+      -> bool
+  {
+    constexpr auto kWordNum = component::GetWordNum<C>() + component::GetWordNum<T>();
+    auto *desc = GetDescriptor<kWordNum, ContentionManager>();
+    if (!desc->SetRDCSSTargets(control, target)) {
+      desc->Discard();
+      return false;
+    }
+    return desc->MwCAS();
+  }
+
+  /**
+   * @brief Update a target only if a control word has an expected value in a given session.
+   *
+   * @tparam ContentionManager a class to decide when to help active MwCAS operations
+   * @tparam C a class of a control word
+   * @tparam T a class of a target
+   * @param session a session created by this domain
+   * @param control a control word and its expected value
+   * @param target a MwCAS target to be updated
+   * @retval true if an RDCSS operation succeeds.
+   * @retval false otherwise (including a target that overlaps the control word).
+   */
+  template <class ContentionManager = EagerHelping, class C, class T>
+  auto
+  RDCSS(  //
+      const Session &session,
+      const CompareTarget<C> &control,
+      const MwCASTarget<T> &target) const  //
+      -> bool
+  {
+    constexpr auto kWordNum = component::GetWordNum<C>() + component::GetWordNum<T>();
+    auto *desc = GetDescriptor<kWordNum, ContentionManager>();
+    if (!desc->SetRDCSSTargets(control, target)) {
+      desc->Discard();
+      return false;
+    }
+    return desc->MwCAS(session);
+  }
+
+  /**
+   * @brief Update a target only if a control word has an expected value in a given session
+   * and report a mismatched word on failure.
+   *
+   * @tparam ContentionManager a class to decide when to help active MwCAS operations
+   * @tparam C a class of a control word
+   * @tparam T a class of a target
+   * @param session a session created by this domain
+   * @param result an output for a mismatched word and its observed value.
+   * @param control a control word and its expected value
+   * @param target a MwCAS target to be updated
+   * @retval true if an RDCSS operation succeeds.
+   * @retval false otherwise (including a target that overlaps the control word).
+   */
+  template <class ContentionManager = EagerHelping, class C, class T>
+  auto
+  RDCSS(  //
+      const Session &session,
+      component::MwCASResult &result,
+      const CompareTarget<C> &control,
+      const MwCASTarget<T> &target) const  //
+      -> bool
+  {
+    constexpr auto kWordNum = component::GetWordNum<C>() + component::GetWordNum<T>();
+    auto *desc = GetDescriptor<kWordNum, ContentionManager>();
+    if (!desc->SetRDCSSTargets(control, target)) {
+      desc->Discard();
+      result = component::MwCASResult{nullptr, component::MwCASField{}};
+      return false;
+    }
+    return desc->MwCAS(session, result);
+  }
+
+  /**
+   * @brief Update multiple targets by using their current values in this domain.
+   *
+   * @tparam T a class of targets
+   * @tparam ContentionManager a class to decide when to help active MwCAS operations
+   * @tparam kN the number of targets
+   * @tparam Fn a class of a function to compute new values
+   * @param addrs target memory addresses (must be distinct)
+   * @param fn a function to compute new values from current ones without side effects
+   * @return the values of targets just before the successful MwCAS operation.
+   */
+  template <class T, class ContentionManager = EagerHelping, size_t kN, class Fn>
+  auto
+  MwCASUpdate(  //
+      const std::array<void *, kN> &addrs,
+      Fn &&fn) const  //
+      -> std::array<T, kN>
+  {
+    const auto session = CreateSession();
+    return MwCASUpdate<T, ContentionManager>(session, addrs, fn);
+  }
+
+  /**
+   * @brief Update multiple targets by using their current values in a given session.
+   *
+   * @tparam T a class of targets
+   * @tparam ContentionManager a class to decide when to help active MwCAS operations
+   * @tparam kN the number of targets
+   * @tparam Fn a class of a function to compute new values
+   * @param session a session created by this domain
+   * @param addrs target memory addresses (must be distinct)
+   * @param fn a function to compute new values from current ones without side effects
+   * @return the values of targets just before the successful MwCAS operation.
+   */
+  template <class T, class ContentionManager = EagerHelping, size_t kN, class Fn>
+  auto
+  MwCASUpdate(  //
+      const Session &session,
+      const std::array<void *, kN> &addrs,
+      Fn &&fn) const  //
+      -> std::array<T, kN>
+  {
+    constexpr auto kWordNum = kN * component::GetWordNum<T>();
+    using Descriptor = AOPTDescriptor<kWordNum, ContentionManager>;
+    return Descriptor::template UpdateInternal<T>(domain_id_, session, addrs, fn);
+  }
+
+  /**
+   * @brief Enter an epoch of this domain across a sequence of operations.
+   *
+   * @return a session that protects descriptors in this domain.
+   */
+  [[nodiscard]] auto
+  CreateSession() const  //
+      -> Session
+  {
+    return Session{domain_id_};
+  }
+
+  /**
+   * @brief Read a value from a given memory address updated via this domain.
+   *
+   * As with DescriptorBase::Read, a 16-byte target costs a locked CAS per read unless
+   * built with AVX.
+   *
+   * @tparam T an expected class of a target field
+   * @tparam kPolicy a policy for active MwCAS operations
+   * @tparam ContentionManager a class to decide when to help active MwCAS operations
+   * @param addr a target memory address to read
+   * @return a read value
+   */
+  template <class T,
+            ReadPolicy kPolicy = ReadPolicy::HELPING,
+            class ContentionManager = EagerHelping>
+  auto
+  Read(void *addr) const  //
+      -> T
+  {
+    const auto session = CreateSession();
+    return Read<T, kPolicy, ContentionManager>(addr, session);
+  }
+
+  /**
+   * @brief Read a value from a given memory address in a given session of this domain.
+   *
+   * @tparam T an expected class of a target field
+   * @tparam kPolicy a policy for active MwCAS operations
+   * @tparam ContentionManager a class to decide when to help active MwCAS operations
+   * @param addr a target memory address to read
+   * @param session a session created by this domain
+   * @return a read value
+   */
+  template <class T,
+            ReadPolicy kPolicy = ReadPolicy::HELPING,
+            class ContentionManager = EagerHelping>
+  auto
+  Read(  //
+      void *addr,
+      const Session &session) const  //
+      -> T
+  {
+    assert(session.domain_id_ == domain_id_);
+    return DescriptorBase::Read<T, kPolicy, ContentionManager>(addr, session);
+  }
+
+  /**
+   * @brief Read values from contiguous target words updated via this domain.
+   *
+   * @tparam T an expected class of target fields
+   * @tparam kPolicy a policy for active MwCAS operations
+   * @tparam ContentionManager a class to decide when to help active MwCAS operations
+   * @param addr the address of the first target word
+   * @param n the number of target words to read
+   * @param out an output array for read values
+   */
+  template <class T,
+            ReadPolicy kPolicy = ReadPolicy::HELPING,
+            class ContentionManager = EagerHelping>
+  void
+  ReadRange(  //
+      void *addr,
+      const size_t n,
+      T *out) const
+  {
+    const auto session = CreateSession();
+    ReadRange<T, kPolicy, ContentionManager>(addr, n, out, session);
+  }
+
+  /**
+   * @brief Read values from contiguous target words in a given session of this domain.
+   *
+   * @tparam T an expected class of target fields
+   * @tparam kPolicy a policy for active MwCAS operations
+   * @tparam ContentionManager a class to decide when to help active MwCAS operations
+   * @param addr the address of the first target word
+   * @param n the number of target words to read
+   * @param out an output array for read values
+   * @param session a session created by this domain
+   */
+  template <class T,
+            ReadPolicy kPolicy = ReadPolicy::HELPING,
+            class ContentionManager = EagerHelping>
+  void
+  ReadRange(  //
+      void *addr,
+      const size_t n,
+      T *out,
+      const Session &session) const
+  {
+    assert(session.domain_id_ == domain_id_);
+    DescriptorBase::ReadRange<T, kPolicy, ContentionManager>(addr, n, out, session);
+  }
+
+  /**
+   * @brief Read the values of multiple targets that coexisted at a certain moment.
+   *
+   * @tparam Ts classes of target fields
+   * @param addrs target memory addresses updated via this domain
+   * @return a tuple of read values
+   */
+  template <class... Ts>
+  auto
+  ReadSnapshot(DescriptorBase::TargetAddress<Ts>... addrs) const  //
+      -> std::tuple<Ts...>
+  {
+    const auto session = CreateSession();
+    return ReadSnapshot<Ts...>(session, addrs...);
+  }
+
+  /**
+   * @brief Read the values of multiple targets that coexisted in a given session.
+   *
+   * @tparam Ts classes of target fields
+   * @param session a session created by this domain
+   * @param addrs target memory addresses updated via this domain
+   * @return a tuple of read values
+   */
+  template <class... Ts>
+  auto
+  ReadSnapshot(  //
+      const Session &session,
+      DescriptorBase::TargetAddress<Ts>... addrs) const  //
+      -> std::tuple<Ts...>
+  {
+    assert(session.domain_id_ == domain_id_);
+    return DescriptorBase::ReadSnapshot<EagerHelping, Ts...>(session, addrs...);
+  }
+
+  /**
+   * @brief Finalize finished descriptors of this domain retained by the current thread.
+   *
+   */
+  void
+  FlushFinishedDescriptors() const
+  {
+    DescriptorBase::FlushFinishedDescriptors(domain_id_);
+  }
+
+ private:
+  /*################################################################################################
+   * Internal member variables
+   *##############################################################################################*/
+
+  /// the ID of this domain
+  size_t domain_id_{};
+};
+
+}  // namespace dbgroup::atomic::aopt
+
+#endif  // MWCAS_AOPT_AOPT_MWCAS_DOMAIN_H_
@@ -43,11 +43,143 @@ constexpr size_t kMaxFinishedDescriptors = MWCAS_AOPT_FINISHED_DESCRIPTOR_THRESH
 constexpr size_t kMaxFinishedDescriptors = 64;
 #endif
 
+#ifdef MWCAS_AOPT_FINALIZE_INTERVAL
+/// The interval in microseconds to finalize descriptors left by idle threads (0: disabled).
+constexpr size_t kFinalizeInterval = MWCAS_AOPT_FINALIZE_INTERVAL;
+#else
+/// The interval in microseconds to finalize descriptors left by idle threads (0: disabled).
+constexpr size_t kFinalizeInterval = 0;
+#endif
+
+#ifdef MWCAS_AOPT_DESCRIPTOR_POOL_CAPACITY
+/// The maximum number of descriptors cached by each thread.
+constexpr size_t kDescriptorPoolCapacity = MWCAS_AOPT_DESCRIPTOR_POOL_CAPACITY;
+#else
+/// The maximum number of descriptors cached by each thread.
+constexpr size_t kDescriptorPoolCapacity = 64;
+#endif
+
+// each thread must be able to cache at least one descriptor
+static_assert(kDescriptorPoolCapacity > 0);
+
+#ifdef MWCAS_AOPT_MAX_HELP_DEPTH
+/// The maximum number of nested descriptors that each thread retains to help at once.
+constexpr size_t kMaxHelpDepth = MWCAS_AOPT_MAX_HELP_DEPTH;
+#else
+/// The maximum number of nested descriptors that each thread retains to help at once.
+constexpr size_t kMaxHelpDepth = 16;
+#endif
+
+// each thread must be able to help at least one descriptor
+static_assert(kMaxHelpDepth > 0);
+
+#ifdef MWCAS_AOPT_MAX_DOMAIN_NUM
+/// The maximum number of MwCAS domains that exist at once (including the default one).
+constexpr size_t kMaxDomainNum = MWCAS_AOPT_MAX_DOMAIN_NUM;
+#else
+/// The maximum number of MwCAS domains that exist at once (including the default one).
+constexpr size_t kMaxDomainNum = 16;
+#endif
+
+// the default domain must exist, and each domain is identified by two bytes
+static_assert(kMaxDomainNum > 0 && kMaxDomainNum <= (1UL << 16UL));
+
+#ifdef MWCAS_AOPT_PRE_VALIDATION
+/// A flag to validate all the targets before installing descriptors.
+constexpr bool kUsePreValidation = true;
+#else
+/// A flag to validate all the targets before installing descriptors.
+constexpr bool kUsePreValidation = false;
+#endif
+
+#ifdef MWCAS_AOPT_UNSORTED_TARGETS
+/// A flag to install MwCAS targets in the order of their addresses.
+constexpr bool kSortTargets = false;
+#else
+/// A flag to install MwCAS targets in the order of their addresses.
+constexpr bool kSortTargets = true;
+#endif
+
+#ifdef MWCAS_AOPT_USE_NUMA
+/// A flag to keep descriptor pages on the NUMA nodes of threads that use them.
+constexpr bool kUseNUMA = true;
+#else
+/// A flag to keep descriptor pages on the NUMA nodes of threads that use them.
+constexpr bool kUseNUMA = false;
+#endif
+
+#ifdef MWCAS_AOPT_ENABLE_STATISTICS
+/// A flag to count events in MwCAS operations.
+constexpr bool kEnableStatistics = true;
+#else
+/// A flag to count events in MwCAS operations.
+constexpr bool kEnableStatistics = false;
+#endif
+
+/**
+ * @brief An enumeration for representing how to read words with active descriptors.
+ *
+ */
+enum class ReadPolicy
+{
+  /// finish active MwCAS operations and return their results
+  HELPING = 0,
+  /// return the expected values of active MwCAS operations without finishing them (except
+  /// for operations with compare-only targets, which are finished as with HELPING)
+  NON_HELPING
+};
+
+/*##################################################################################################
+ * Global utility structs
+ *################################################################################################*/
+
+/**
+ * @brief A struct to represent a MwCAS target whose registration is known at compile
+ * time (e.g., `MwCAS(MwCASTarget{addr_1, old_1, new_1}, MwCASTarget{addr_2, old_2, new_2})`).
+ *
+ * @tparam T a class of a target
+ */
+template <class T>
+struct MwCASTarget {
+  /// a target memory address
+  void *addr;
+
+  /// an expected value of a target field
+  T old_val;
+
+  /// an inserting value into a target field
+  T new_val;
+};
+
+// deduce the class of a target from its values
+template <class T>
+MwCASTarget(void *, T, T) -> MwCASTarget<T>;
+
+/**
+ * @brief A struct to represent a compare-only target (e.g., the control word of RDCSS).
+ *
+ * @tparam T a class of a target
+ */
+template <class T>
+struct CompareTarget {
+  /// a target memory address
+  void *addr;
+
+  /// an expected value of a target field
+  T expected;
+};
+
+// deduce the class of a target from its value
+template <class T>
+CompareTarget(void *, T) -> CompareTarget<T>;
+
 /*##################################################################################################
  * Global utility functions
  *################################################################################################*/
 
 /**
+ * Applications can specialize this function for their own 8-byte or 16-byte classes.
+ *
  * @tparam T a MwCAS target class.
  * @retval true if a target class can be updated by MwCAS.
  * @retval false otherwise.
@@ -16,11 +16,15 @@
 
 #include "aopt/aopt_descriptor.hpp"
 
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <future>
 #include <mutex>
 #include <random>
 #include <shared_mutex>
 #include <thread>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -43,23 +47,32 @@ class AOPTDescriptorFixture : public ::testing::Test
       target_fields_[i] = 0UL;
     }
 
-    AOPTDescriptor::StartGC();
+    AOPTDescriptor<>::StartGC();
   }
 
   void
   TearDown() override
   {
-    AOPTDescriptor::StopGC();
+    AOPTDescriptor<>::StopGC();
   }
 
+  /*################################################################################################
+   * Internal constants
+   *##############################################################################################*/
+
+  static constexpr size_t kSmallCapacity = (kMwCASCapacity + 1) / 2;
+
   /*################################################################################################
    * Functions for verification
    *##############################################################################################*/
 
   void
-  VerifyMwCAS(const size_t thread_num)
+  VerifyMwCAS(  //
+      const size_t thread_num,
+      const size_t sub_capacity = kMwCASCapacity,
+      const bool use_session = false)
   {
-    RunMwCAS(thread_num);
+    RunMwCAS(thread_num, sub_capacity, use_session);
 
     // check the target fields are correctly incremented
     size_t sum = 0;
@@ -67,7 +80,894 @@ class AOPTDescriptorFixture : public ::testing::Test
       sum += target;
     }
 
-    EXPECT_EQ(kExecNum * thread_num * kMwCASCapacity, sum);
+    size_t expected = 0;
+    for (size_t i = 0; i < thread_num; ++i) {
+      expected += kExecNum * ((i % 2 == 1) ? sub_capacity : kMwCASCapacity);
+    }
+    EXPECT_EQ(expected, sum);
+  }
+
+  void
+  VerifyPageAlignment()
+  {
+    RunInWorker([&]() {
+      auto *desc = AOPTDescriptor<>::GetDescriptor();
+      EXPECT_EQ(0, reinterpret_cast<uintptr_t>(desc) % component::kDescriptorPageSize);
+      desc->AddMwCASTarget(&(target_fields_[0]), Target{0}, Target{1});
+      EXPECT_TRUE(desc->MwCAS());
+    });
+  }
+
+  void
+  VerifyAddMwCASTarget()
+  {
+    RunInWorker([&]() {
+      auto *desc = AOPTDescriptor<>::GetDescriptor();
+
+      // register targets in the reverse order of their addresses
+      for (size_t i = kMwCASCapacity; i > 0; --i) {
+        auto *addr = &(target_fields_[i - 1]);
+        EXPECT_TRUE(desc->AddMwCASTarget(addr, Target{0}, Target{i}));
+        EXPECT_FALSE(desc->AddMwCASTarget(addr, Target{0}, Target{i}));
+      }
+      EXPECT_EQ(kMwCASCapacity, desc->Size());
+
+      // the descriptor is already full
+      Target extra_field{0};
+      EXPECT_FALSE(desc->AddMwCASTarget(&extra_field, Target{0}, Target{0}));
+
+      // each target should be updated regardless of the order of registration
+      EXPECT_TRUE(desc->MwCAS());
+      for (size_t i = 0; i < kMwCASCapacity; ++i) {
+        EXPECT_EQ(i + 1, AOPTDescriptor<>::Read<Target>(&(target_fields_[i])));
+      }
+    });
+  }
+
+  void
+  VerifyMwCASResult()
+  {
+    RunInWorker([&]() {
+      constexpr Target kUnexpected = 10;
+      auto *failed_addr = &(target_fields_[kMwCASCapacity - 1]);
+      *failed_addr = kUnexpected;
+
+      // a failed MwCAS reports a mismatched word
+      auto *desc = AOPTDescriptor<>::GetDescriptor();
+      for (size_t i = 0; i < kMwCASCapacity; ++i) {
+        desc->AddMwCASTarget(&(target_fields_[i]), Target{0}, Target{1});
+      }
+      AOPTDescriptor<>::MwCASResult failed{};
+      EXPECT_FALSE(desc->MwCAS(failed));
+      EXPECT_FALSE(failed);
+      EXPECT_EQ(failed_addr, failed.GetFailedAddress());
+      EXPECT_EQ(kUnexpected, failed.GetObservedValue<Target>());
+
+      // the next MwCAS can use the observed value without reading the address
+      desc = AOPTDescriptor<>::GetDescriptor();
+      for (size_t i = 0; i < kMwCASCapacity; ++i) {
+        auto *addr = &(target_fields_[i]);
+        const auto old_val =
+            (addr == failed.GetFailedAddress()) ? failed.GetObservedValue<Target>() : Target{0};
+        desc->AddMwCASTarget(addr, old_val, old_val + 1);
+      }
+      AOPTDescriptor<>::MwCASResult succeeded{};
+      EXPECT_TRUE(desc->MwCAS(succeeded));
+      EXPECT_TRUE(succeeded);
+      EXPECT_EQ(nullptr, succeeded.GetFailedAddress());
+      EXPECT_EQ(kUnexpected + 1, AOPTDescriptor<>::Read<Target>(failed_addr));
+
+      // the detailed result is opt-in, and so MwCAS can be used as bool
+      desc = AOPTDescriptor<>::GetDescriptor();
+      desc->AddMwCASTarget(failed_addr, kUnexpected + 1, kUnexpected + 2);
+      const bool success = desc->MwCAS();
+      EXPECT_TRUE(success);
+    });
+  }
+
+  void
+  VerifyPreValidation()
+  {
+    RunInWorker([&]() {
+      target_fields_[0] = 1;
+
+      // a MwCAS with a stale value fails without writing target words
+      auto *desc = AOPTDescriptor<>::GetDescriptor();
+      for (size_t i = 0; i < kMwCASCapacity; ++i) {
+        desc->AddMwCASTarget(&(target_fields_[i]), Target{0}, Target{2});
+      }
+      EXPECT_FALSE(desc->MwCAS());
+      for (size_t i = 0; i < kMwCASCapacity; ++i) {
+        const Target expected = (i == 0) ? 1 : 0;
+        EXPECT_EQ(expected, target_fields_[i]);
+      }
+
+      // the failed descriptor has been recycled immediately
+      EXPECT_EQ(static_cast<void *>(desc), AOPTDescriptor<>::GetDescriptor());
+    });
+  }
+
+  void
+  VerifyUnpublishedFailure()
+  {
+    RunInWorker([&]() {
+      // the first target in the address order has an unexpected value
+      target_fields_[0] = 1;
+
+      auto *desc = AOPTDescriptor<>::GetDescriptor();
+      for (size_t i = kMwCASCapacity; i > 0; --i) {
+        desc->AddMwCASTarget(&(target_fields_[i - 1]), Target{0}, Target{2});
+      }
+      EXPECT_FALSE(desc->MwCAS());
+      for (size_t i = 0; i < kMwCASCapacity; ++i) {
+        const Target expected = (i == 0) ? 1 : 0;
+        EXPECT_EQ(expected, LoadRawWord(i));
+      }
+
+      // the failed descriptor has been recycled without waiting for GC
+      EXPECT_EQ(static_cast<void *>(desc), AOPTDescriptor<>::GetDescriptor());
+    });
+  }
+
+  void
+  VerifyCompareTarget()
+  {
+    RunInWorker([&]() {
+      auto *cmp_addr = &(target_fields_[kMwCASCapacity - 1]);
+      *cmp_addr = 1;
+
+      // compare-only targets are validated without installing descriptors
+      auto *desc = AOPTDescriptor<>::GetDescriptor();
+      EXPECT_TRUE(desc->AddCompareTarget(cmp_addr, Target{1}));
+      EXPECT_FALSE(desc->AddMwCASTarget(cmp_addr, Target{1}, Target{2}));
+      for (size_t i = 0; i < kMwCASCapacity - 1; ++i) {
+        desc->AddMwCASTarget(&(target_fields_[i]), Target{0}, Target{1});
+      }
+      EXPECT_TRUE(desc->MwCAS());
+      EXPECT_EQ(Target{1}, LoadRawWord(kMwCASCapacity - 1));
+      for (size_t i = 0; i < kMwCASCapacity - 1; ++i) {
+        EXPECT_EQ(Target{1}, AOPTDescriptor<>::Read<Target>(&(target_fields_[i])));
+      }
+
+      // a MwCAS fails if a compare-only target has an unexpected value
+      desc = AOPTDescriptor<>::GetDescriptor();
+      desc->AddCompareTarget(cmp_addr, Target{0});
+      for (size_t i = 0; i < kMwCASCapacity - 1; ++i) {
+        desc->AddMwCASTarget(&(target_fields_[i]), Target{1}, Target{2});
+      }
+      AOPTDescriptor<>::MwCASResult result{};
+      EXPECT_FALSE(desc->MwCAS(result));
+      EXPECT_EQ(cmp_addr, result.GetFailedAddress());
+      EXPECT_EQ(Target{1}, result.GetObservedValue<Target>());
+      for (size_t i = 0; i < kMwCASCapacity - 1; ++i) {
+        EXPECT_EQ(Target{1}, AOPTDescriptor<>::Read<Target>(&(target_fields_[i])));
+      }
+    });
+  }
+
+  void
+  VerifyCompareTargetsWithTransfers(const size_t thread_num)
+  {
+    // move values between two words while other threads validate their sum
+    auto *src = &(target_fields_[0]);
+    auto *dest = &(target_fields_[1]);
+    auto *sum = &(target_fields_[2]);
+    *src = kExecNum * thread_num;
+
+    auto transfer = [&]() {
+      for (size_t i = 0; i < kExecNum; ++i) {
+        while (true) {
+          auto *desc = AOPTDescriptor<>::GetDescriptor();
+          const auto src_val = AOPTDescriptor<>::Read<Target>(src);
+          const auto dest_val = AOPTDescriptor<>::Read<Target>(dest);
+          desc->AddMwCASTarget(src, src_val, src_val - 1);
+          desc->AddMwCASTarget(dest, dest_val, dest_val + 1);
+          if (desc->MwCAS()) break;
+        }
+      }
+    };
+    auto validate = [&]() {
+      for (size_t i = 0; i < kExecNum; ++i) {
+        auto *desc = AOPTDescriptor<>::GetDescriptor();
+        const auto src_val = AOPTDescriptor<>::Read<Target>(src);
+        const auto dest_val = AOPTDescriptor<>::Read<Target>(dest);
+        const auto sum_val = AOPTDescriptor<>::Read<Target>(sum);
+        desc->AddCompareTarget(src, src_val);
+        desc->AddCompareTarget(dest, dest_val);
+        desc->AddMwCASTarget(sum, sum_val, src_val + dest_val);
+        if (desc->MwCAS()) {
+          // the validated values must be a consistent snapshot
+          EXPECT_EQ(kExecNum * thread_num, src_val + dest_val);
+        }
+      }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < thread_num; ++i) {
+      threads.emplace_back(transfer);
+      threads.emplace_back(validate);
+    }
+    for (auto &&t : threads) t.join();
+
+    EXPECT_EQ(Target{0}, *src);
+    EXPECT_EQ(kExecNum * thread_num, *dest);
+  }
+
+  template <size_t kWordNum>
+  void
+  VerifyCrossedCompareTargets(  //
+      std::integral_constant<size_t, kWordNum>,
+      const bool help_higher_first)
+  {
+    // each operation updates its words only if the word of the other is unchanged
+    std::array<Target *, 2> words{&(target_fields_[0]), &(target_fields_[1])};
+    std::array<Target *, 2> subs{&(target_fields_[2]), &(target_fields_[3])};
+    for (size_t id = 0; id < 2; ++id) {
+      *words[id] = 0;
+      *subs[id] = 0;
+    }
+    std::array<void *, 2> descs{};
+    std::array<AOPTDescriptor<>::MwCASResult, 2> results{};
+    auto run = [&](const size_t id) {
+      auto *desc = AOPTDescriptor<kWordNum, GateCM>::GetDescriptor();
+      desc->AddMwCASTarget(words[id], Target{0}, Target{1});
+      desc->AddMwCASTarget(subs[id], Target{0}, Target{1});
+      desc->AddCompareTarget(words[1 - id], Target{0});
+      descs[id] = desc;
+      desc->MwCAS(results[id]);
+    };
+
+    RunInWorker([&]() {
+      // both the operations embed their first words and are blocked at the second ones
+      StallWords(subs);
+      GateCM::Close();
+      std::thread op_0{run, 0};
+      std::thread op_1{run, 1};
+      GateCM::WaitFor(2);
+
+      // validate the operations one by one while both of them are active
+      AOPTDescriptor<>::Read<Target>(subs[0]);
+      const size_t lower = (std::less<void *>{}(descs[0], descs[1])) ? 0 : 1;
+      const size_t first = (help_higher_first) ? 1 - lower : lower;
+      AOPTDescriptor<>::Read<Target>(words[first]);
+      AOPTDescriptor<>::Read<Target>(words[1 - first]);
+      GateCM::Open();
+      op_0.join();
+      op_1.join();
+
+      // the lower descriptor wins regardless of the order, and the other observes it
+      EXPECT_TRUE(results[lower]);
+      EXPECT_FALSE(results[1 - lower]);
+      EXPECT_EQ(words[lower], results[1 - lower].GetFailedAddress());
+      EXPECT_EQ(Target{1}, AOPTDescriptor<>::Read<Target>(words[lower]));
+      EXPECT_EQ(Target{1}, AOPTDescriptor<>::Read<Target>(subs[lower]));
+      EXPECT_EQ(Target{0}, AOPTDescriptor<>::Read<Target>(words[1 - lower]));
+      EXPECT_EQ(Target{0}, AOPTDescriptor<>::Read<Target>(subs[1 - lower]));
+    });
+  }
+
+  void
+  VerifyWideTarget()
+  {
+    RunInWorker([&]() {
+      auto *wide_addr = &wide_field_;
+      const MyWideClass init{0, 0, 0};
+      const MyWideClass next{1, 0, 1};
+
+      // a double-width target uses two entries and can be mixed with 8-byte targets
+      auto *desc = AOPTDescriptor<>::GetDescriptor();
+      EXPECT_TRUE(desc->AddMwCASTarget(wide_addr, init, next));
+      EXPECT_FALSE(desc->AddMwCASTarget(&(wide_addr->version), Target{0}, Target{1}));
+      for (size_t i = 0; i < kMwCASCapacity - 2; ++i) {
+        EXPECT_TRUE(desc->AddMwCASTarget(&(target_fields_[i]), Target{0}, Target{1}));
+      }
+      auto *extra_addr = &(target_fields_[kMwCASCapacity - 2]);
+      EXPECT_FALSE(desc->AddMwCASTarget(extra_addr, Target{0}, Target{1}));
+      EXPECT_TRUE(desc->MwCAS());
+      EXPECT_EQ(next, AOPTDescriptor<>::Read<MyWideClass>(wide_addr));
+      for (size_t i = 0; i < kMwCASCapacity - 2; ++i) {
+        EXPECT_EQ(Target{1}, AOPTDescriptor<>::Read<Target>(&(target_fields_[i])));
+      }
+
+      // a stale double-width target is reported with its observed value
+      desc = AOPTDescriptor<>::GetDescriptor();
+      desc->AddMwCASTarget(wide_addr, init, next);
+      for (size_t i = 0; i < kMwCASCapacity - 2; ++i) {
+        desc->AddMwCASTarget(&(target_fields_[i]), Target{1}, Target{2});
+      }
+      AOPTDescriptor<>::MwCASResult result{};
+      EXPECT_FALSE(desc->MwCAS(result));
+      EXPECT_EQ(wide_addr, result.GetFailedAddress());
+      EXPECT_EQ(next, result.GetObservedValue<MyWideClass>());
+      for (size_t i = 0; i < kMwCASCapacity - 2; ++i) {
+        EXPECT_EQ(Target{1}, AOPTDescriptor<>::Read<Target>(&(target_fields_[i])));
+      }
+    });
+  }
+
+  void
+  VerifyWideTargetWithMultiThreads(const size_t thread_num)
+  {
+    // increment both words of a double-width target and an 8-byte counter at once
+    auto *wide_addr = &wide_field_;
+    auto *counter = &(target_fields_[0]);
+
+    auto increment = [&]() {
+      for (size_t i = 0; i < kExecNum; ++i) {
+        while (true) {
+          auto *desc = AOPTDescriptor<>::GetDescriptor();
+          const auto cur_wide = AOPTDescriptor<>::Read<MyWideClass>(wide_addr);
+          const auto cur_cnt = AOPTDescriptor<>::Read<Target>(counter);
+          const MyWideClass new_wide{cur_wide.data + 1, 0, cur_wide.version + 1};
+          desc->AddMwCASTarget(wide_addr, cur_wide, new_wide);
+          desc->AddMwCASTarget(counter, cur_cnt, cur_cnt + 1);
+          if (desc->MwCAS()) break;
+        }
+      }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < thread_num; ++i) {
+      threads.emplace_back(increment);
+    }
+    for (auto &&t : threads) t.join();
+
+    // exited threads have finalized their descriptors, so both words have final values
+    EXPECT_EQ(kExecNum * thread_num, wide_addr->data);
+    EXPECT_EQ(kExecNum * thread_num, wide_addr->version);
+    EXPECT_EQ(kExecNum * thread_num, *counter);
+  }
+
+  template <size_t kWordNum>
+  void
+  VerifyFixedTargets(std::integral_constant<size_t, kWordNum>)
+  {
+    RunInWorker([&]() {
+      auto *addr_0 = &(target_fields_[0]);
+      auto *addr_1 = &(target_fields_[1]);
+
+      // targets are sorted regardless of the order of arguments
+      EXPECT_TRUE(MwCAS(MwCASTarget{addr_1, Target{0}, Target{2}},  //
+                        MwCASTarget{addr_0, Target{0}, Target{1}}));
+      EXPECT_EQ(Target{1}, AOPTDescriptor<>::Read<Target>(addr_0));
+      EXPECT_EQ(Target{2}, AOPTDescriptor<>::Read<Target>(addr_1));
+
+      // a stale target is reported with its observed value
+      const AOPTDescriptor<>::Session session{};
+      AOPTDescriptor<>::MwCASResult result{};
+      EXPECT_FALSE(MwCAS(session, result, MwCASTarget{addr_0, Target{1}, Target{3}},
+                         MwCASTarget{addr_1, Target{0}, Target{3}}));
+      EXPECT_EQ(addr_1, result.GetFailedAddress());
+      EXPECT_EQ(Target{2}, result.GetObservedValue<Target>());
+      EXPECT_EQ(Target{1}, AOPTDescriptor<>::Read<Target>(addr_0, session));
+
+      // duplicate addresses are rejected without writing any target
+      EXPECT_FALSE(MwCAS(session, result, MwCASTarget{addr_0, Target{1}, Target{3}},
+                         MwCASTarget{addr_0, Target{1}, Target{4}}));
+      EXPECT_EQ(nullptr, result.GetFailedAddress());
+      EXPECT_FALSE(
+          RDCSS(CompareTarget{addr_1, Target{2}}, MwCASTarget{addr_1, Target{2}, Target{3}}));
+      EXPECT_EQ(Target{1}, AOPTDescriptor<>::Read<Target>(addr_0, session));
+      EXPECT_EQ(Target{2}, AOPTDescriptor<>::Read<Target>(addr_1, session));
+    });
+  }
+
+  template <size_t kWordNum>
+  void
+  VerifyFixedTargetsWithWideTarget(std::integral_constant<size_t, kWordNum>)
+  {
+    auto *addr = &(target_fields_[0]);
+    const MyWideClass init{0, 0, 0};
+    const MyWideClass next{1, 0, 1};
+
+    // a double-width target is counted as two words
+    EXPECT_TRUE(MwCAS(MwCASTarget{addr, Target{0}, Target{1}},  //
+                      MwCASTarget{&wide_field_, init, next}));
+    EXPECT_EQ(Target{1}, AOPTDescriptor<>::Read<Target>(addr));
+    EXPECT_EQ(next, AOPTDescriptor<>::Read<MyWideClass>(&wide_field_));
+  }
+
+  template <size_t kWordNum>
+  void
+  VerifyFixedTargetsWithMultiThreads(  //
+      std::integral_constant<size_t, kWordNum>,
+      const size_t thread_num)
+  {
+    auto *addr_0 = &(target_fields_[0]);
+    auto *addr_1 = &(target_fields_[1]);
+    auto *addr_2 = &(target_fields_[2]);
+
+    auto increment = [&]() {
+      for (size_t i = 0; i < kExecNum; ++i) {
+        const AOPTDescriptor<>::Session session{};
+        while (true) {
+          const auto cur_0 = AOPTDescriptor<>::Read<Target>(addr_0, session);
+          const auto cur_1 = AOPTDescriptor<>::Read<Target>(addr_1, session);
+          if constexpr (kWordNum == 3) {
+            const auto cur_2 = AOPTDescriptor<>::Read<Target>(addr_2, session);
+            if (MwCAS(session, MwCASTarget{addr_2, cur_2, cur_2 + 1},
+                      MwCASTarget{addr_0, cur_0, cur_0 + 1},
+                      MwCASTarget{addr_1, cur_1, cur_1 + 1})) {
+              break;
+            }
+          } else {
+            if (MwCAS(session, MwCASTarget{addr_1, cur_1, cur_1 + 1},
+                      MwCASTarget{addr_0, cur_0, cur_0 + 1})) {
+              break;
+            }
+          }
+        }
+      }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < thread_num; ++i) {
+      threads.emplace_back(increment);
+    }
+    for (auto &&t : threads) t.join();
+
+    for (size_t i = 0; i < kWordNum; ++i) {
+      EXPECT_EQ(kExecNum * thread_num, target_fields_[i]);
+    }
+  }
+
+  template <size_t kWordNum>
+  void
+  VerifyRDCSS(std::integral_constant<size_t, kWordNum>)
+  {
+    RunInWorker([&]() {
+      auto *ctrl = &(target_fields_[0]);
+      auto *addr = &(target_fields_[1]);
+      *ctrl = 1;
+
+      // a changed control word fails RDCSS without writing the target
+      EXPECT_FALSE(
+          RDCSS(CompareTarget{ctrl, Target{0}}, MwCASTarget{addr, Target{0}, Target{1}}));
+      EXPECT_EQ(Target{0}, LoadRawWord(1));
+
+      // the failure can be reported with a mismatched word
+      const AOPTDescriptor<>::Session session{};
+      AOPTDescriptor<>::MwCASResult failed{};
+      EXPECT_FALSE(RDCSS(session, failed, CompareTarget{ctrl, Target{0}},
+                         MwCASTarget{addr, Target{0}, Target{1}}));
+      EXPECT_EQ(ctrl, failed.GetFailedAddress());
+      EXPECT_EQ(Target{1}, failed.GetObservedValue<Target>());
+      EXPECT_EQ(Target{0}, LoadRawWord(1));
+
+      EXPECT_TRUE(RDCSS(CompareTarget{ctrl, Target{1}}, MwCASTarget{addr, Target{0}, Target{1}}));
+      EXPECT_EQ(Target{1}, AOPTDescriptor<>::Read<Target>(addr));
+
+      // the control word is never occupied by a descriptor
+      EXPECT_EQ(Target{1}, LoadRawWord(0));
+
+      // a stale target is reported as well as MwCAS
+      AOPTDescriptor<>::MwCASResult stale{};
+      EXPECT_FALSE(RDCSS(session, stale, CompareTarget{ctrl, Target{1}},
+                         MwCASTarget{addr, Target{0}, Target{2}}));
+      EXPECT_EQ(addr, stale.GetFailedAddress());
+      EXPECT_EQ(Target{1}, stale.GetObservedValue<Target>());
+    });
+  }
+
+  template <size_t kWordNum>
+  void
+  VerifyCrossedRDCSS(  //
+      std::integral_constant<size_t, kWordNum>,
+      const bool help_higher_first)
+  {
+    // each RDCSS updates its word only if the word of the other is unchanged
+    std::array<Target *, 2> words{&(target_fields_[0]), &(target_fields_[1])};
+    for (auto *word : words) {
+      *word = 0;
+    }
+
+    RunInWorker([&]() {
+      // publish both the operations as if their owners had stopped after embedding them
+      std::array<AOPTDescriptor<kWordNum> *, 2> descs{};
+      for (size_t id = 0; id < 2; ++id) {
+        descs[id] = AOPTDescriptor<kWordNum>::GetDescriptor();
+        ASSERT_TRUE(descs[id]->SetRDCSSTargets(CompareTarget{words[1 - id], Target{0}},
+                                               MwCASTarget{words[id], Target{0}, Target{1}}));
+      }
+      for (size_t id = 0; id < 2; ++id) {
+        EmbedWord(descs[id], 0, words[id]);
+      }
+
+      // validate the operations one by one while both of them are active
+      const size_t lower = (std::less<void *>{}(descs[0], descs[1])) ? 0 : 1;
+      const size_t first = (help_higher_first) ? 1 - lower : lower;
+      AOPTDescriptor<>::Read<Target>(words[first]);
+      AOPTDescriptor<>::Read<Target>(words[1 - first]);
+
+      // the lower descriptor wins regardless of the order
+      EXPECT_EQ(component::Status::SUCCESSFUL, descs[lower]->GetStatus());
+      EXPECT_EQ(component::Status::FAILED, descs[1 - lower]->GetStatus());
+      EXPECT_EQ(Target{1}, AOPTDescriptor<>::Read<Target>(words[lower]));
+      EXPECT_EQ(Target{0}, AOPTDescriptor<>::Read<Target>(words[1 - lower]));
+    });
+  }
+
+  template <size_t kWordNum>
+  void
+  VerifyRDCSSWithMultiThreads(  //
+      std::integral_constant<size_t, kWordNum>,
+      const size_t thread_num)
+  {
+    auto *ctrl = &(target_fields_[0]);
+    auto *addr = &(target_fields_[1]);
+
+    // each thread alternately increments the control word and the target
+    std::atomic_size_t success_num{0};
+    auto run = [&]() {
+      for (size_t i = 0; i < kExecNum; ++i) {
+        const AOPTDescriptor<>::Session session{};
+        while (true) {
+          const auto cur_ctrl = AOPTDescriptor<>::Read<Target>(ctrl, session);
+          if (i % 2 == 0) {
+            if (MwCAS(session, MwCASTarget{ctrl, cur_ctrl, cur_ctrl + 1})) break;
+            continue;
+          }
+
+          // RDCSS on a target fails if the control word has been incremented
+          const auto cur_val = AOPTDescriptor<>::Read<Target>(addr, session);
+          if (RDCSS(session, CompareTarget{ctrl, cur_ctrl},
+                    MwCASTarget{addr, cur_val, cur_val + 1})) {
+            ++success_num;
+            break;
+          }
+        }
+      }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < thread_num; ++i) {
+      threads.emplace_back(run);
+    }
+    for (auto &&t : threads) t.join();
+
+    EXPECT_EQ(thread_num * ((kExecNum + 1) / 2), target_fields_[0]);
+    EXPECT_EQ(success_num.load(), target_fields_[1]);
+    EXPECT_EQ(thread_num * (kExecNum / 2), target_fields_[1]);
+  }
+
+  void
+  VerifyMwCASUpdate()
+  {
+    std::array<void *, kMwCASCapacity> addrs{};
+    for (size_t i = 0; i < kMwCASCapacity; ++i) {
+      addrs[i] = &(target_fields_[i]);
+    }
+
+    const auto get_num = AOPTDescriptor<>::GetPoolStatistics().get_num;
+    RunInWorker([&]() {
+      // the first call emulates another thread that updates a target concurrently
+      size_t call_num = 0;
+      auto increment = [&](const std::array<Target, kMwCASCapacity> &cur_vals) {
+        if (call_num++ == 0) {
+          target_fields_[0] = 10;
+        }
+        auto new_vals = cur_vals;
+        for (auto &&val : new_vals) ++val;
+        return new_vals;
+      };
+
+      const auto old_vals = MwCASUpdate<Target>(addrs, increment);
+      EXPECT_EQ(2, call_num);
+      for (size_t i = 0; i < kMwCASCapacity; ++i) {
+        const Target expected = (i == 0) ? 10 : 0;
+        EXPECT_EQ(expected, old_vals[i]);
+        EXPECT_EQ(expected + 1, AOPTDescriptor<>::Read<Target>(addrs[i]));
+      }
+    });
+
+    // the unpublished descriptor of the failed attempt has been reused
+    EXPECT_EQ(get_num + 1, AOPTDescriptor<>::GetPoolStatistics().get_num);
+  }
+
+  void
+  VerifyMwCASUpdateWithMultiThreads(const size_t thread_num)
+  {
+    std::array<void *, kMwCASCapacity> addrs{};
+    for (size_t i = 0; i < kMwCASCapacity; ++i) {
+      addrs[i] = &(target_fields_[i]);
+    }
+    auto increment = [](const std::array<Target, kMwCASCapacity> &cur_vals) {
+      auto new_vals = cur_vals;
+      for (auto &&val : new_vals) ++val;
+      return new_vals;
+    };
+
+    auto run = [&]() {
+      for (size_t i = 0; i < kExecNum; ++i) {
+        if (i % 2 == 0) {
+          MwCASUpdate<Target>(addrs, increment);
+        } else {
+          const AOPTDescriptor<>::Session session{};
+          MwCASUpdate<Target>(session, addrs, increment);
+        }
+      }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < thread_num; ++i) {
+      threads.emplace_back(run);
+    }
+    for (auto &&t : threads) t.join();
+
+    for (size_t i = 0; i < kMwCASCapacity; ++i) {
+      EXPECT_EQ(thread_num * kExecNum, AOPTDescriptor<>::Read<Target>(addrs[i]));
+    }
+  }
+
+  void
+  VerifyReadSnapshot()
+  {
+    auto *addr = &(target_fields_[0]);
+    const MyWideClass wide{1, 0, 2};
+    wide_field_ = wide;
+
+    const auto get_num = AOPTDescriptor<>::GetPoolStatistics().get_num;
+    std::thread reader{[&]() {
+      const auto [val, wide_val] = AOPTDescriptor<>::ReadSnapshot<Target, MyWideClass>(  //
+          addr, &wide_field_);
+      EXPECT_EQ(Target{0}, val);
+      EXPECT_EQ(wide, wide_val);
+    }};
+    reader.join();
+
+    // a snapshot does not use any descriptor
+    EXPECT_EQ(get_num, AOPTDescriptor<>::GetPoolStatistics().get_num);
+  }
+
+  void
+  VerifyReadSnapshotWithTransfers(const size_t thread_num)
+  {
+    // move values between two words while other threads read their sum
+    auto *src = &(target_fields_[0]);
+    auto *dest = &(target_fields_[1]);
+    const auto total = kExecNum * thread_num;
+    *src = total;
+
+    auto transfer = [&]() {
+      for (size_t i = 0; i < kExecNum; ++i) {
+        while (true) {
+          auto *desc = AOPTDescriptor<>::GetDescriptor();
+          const auto src_val = AOPTDescriptor<>::Read<Target>(src);
+          const auto dest_val = AOPTDescriptor<>::Read<Target>(dest);
+          desc->AddMwCASTarget(src, src_val, src_val - 1);
+          desc->AddMwCASTarget(dest, dest_val, dest_val + 1);
+          if (desc->MwCAS()) break;
+        }
+      }
+    };
+    auto read = [&]() {
+      for (size_t i = 0; i < kExecNum; ++i) {
+        // both the words are monotonic, and so a snapshot must be consistent
+        const auto [src_val, dest_val] = AOPTDescriptor<>::ReadSnapshot<Target, Target>(src, dest);
+        EXPECT_EQ(total, src_val + dest_val);
+      }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < thread_num; ++i) {
+      threads.emplace_back(transfer);
+      threads.emplace_back(read);
+    }
+    for (auto &&t : threads) t.join();
+
+    EXPECT_EQ(Target{0}, *src);
+    EXPECT_EQ(total, *dest);
+  }
+
+  void
+  VerifyReadRange()
+  {
+    // cover both the bulk copies and the remaining words
+    constexpr size_t kWordNum = 2 * component::kCopyWordNum + 3;
+    std::vector<Target> words(kWordNum);
+    for (size_t i = 0; i < kWordNum; ++i) {
+      words[i] = i;
+    }
+
+    RunInWorker([&]() {
+      // finished descriptors remain in some words until finalization
+      auto *desc = AOPTDescriptor<>::GetDescriptor();
+      for (size_t i = 1, j = 0; i < kWordNum && j < kMwCASCapacity; i += 7, ++j) {
+        desc->AddMwCASTarget(&(words[i]), Target{i}, Target{i + kWordNum});
+      }
+      EXPECT_TRUE(desc->MwCAS());
+
+      std::vector<Target> out(kWordNum);
+      AOPTDescriptor<>::ReadRange(words.data(), kWordNum, out.data());
+      for (size_t i = 0; i < kWordNum; ++i) {
+        const auto expected = (i % 7 == 1 && i / 7 < kMwCASCapacity) ? i + kWordNum : i;
+        EXPECT_EQ(expected, out[i]);
+      }
+
+      // the target words must be released before the vector
+      AOPTDescriptor<>::FlushFinishedDescriptors();
+    });
+  }
+
+  void
+  VerifyReadRangeFromEachOffset()
+  {
+    // bulk copies start at the first cache-line boundary after a given address
+    constexpr size_t kWordNum = 3 * component::kCopyWordNum;
+    alignas(component::kCacheLineSize) std::array<Target, kWordNum> words{};
+    for (size_t i = 0; i < kWordNum; ++i) {
+      words[i] = i;
+    }
+
+    std::vector<Target> out(kWordNum);
+    for (size_t begin = 0; begin < component::kCopyWordNum; ++begin) {
+      for (auto n : {size_t{1}, component::kCopyWordNum, kWordNum - begin}) {
+        AOPTDescriptor<>::ReadRange(&(words[begin]), n, out.data());
+        for (size_t i = 0; i < n; ++i) {
+          EXPECT_EQ(begin + i, out[i]);
+        }
+      }
+    }
+  }
+
+  void
+  VerifyReadRangeDuringMwCAS(const size_t thread_num)
+  {
+    std::atomic_bool is_running{true};
+
+    // target fields are only incremented, so read values must not decrease
+    std::thread reader{[&]() {
+      std::vector<Target> prev_vals(kTargetFieldNum, 0);
+      std::vector<Target> vals(kTargetFieldNum);
+      while (is_running.load(std::memory_order_relaxed)) {
+        AOPTDescriptor<>::ReadRange(target_fields_, kTargetFieldNum, vals.data());
+        for (size_t i = 0; i < kTargetFieldNum; ++i) {
+          EXPECT_LE(prev_vals[i], vals[i]);
+          prev_vals[i] = vals[i];
+        }
+      }
+    }};
+
+    VerifyMwCAS(thread_num);
+
+    is_running.store(false, std::memory_order_relaxed);
+    reader.join();
+  }
+
+  void
+  VerifyFlushFinishedDescriptors()
+  {
+    RunInWorker([&]() {
+      auto *desc = AOPTDescriptor<>::GetDescriptor();
+      for (size_t i = 0; i < kMwCASCapacity; ++i) {
+        desc->AddMwCASTarget(&(target_fields_[i]), Target{0}, Target{1});
+      }
+      EXPECT_TRUE(desc->MwCAS());
+
+      // target words point to the finished descriptor until finalization
+      for (size_t i = 0; i < kMwCASCapacity; ++i) {
+        EXPECT_NE(Target{1}, LoadRawWord(i));
+      }
+
+      AOPTDescriptor<>::FlushFinishedDescriptors();
+      for (size_t i = 0; i < kMwCASCapacity; ++i) {
+        EXPECT_EQ(Target{1}, LoadRawWord(i));
+      }
+    });
+  }
+
+  void
+  VerifyBackgroundFinalization()
+  {
+    std::promise<void> mwcas_finished{};
+    std::promise<void> can_exit{};
+
+    // the worker becomes idle while retaining its finished descriptor
+    std::thread worker{[&]() {
+      auto *desc = AOPTDescriptor<>::GetDescriptor();
+      for (size_t i = 0; i < kMwCASCapacity; ++i) {
+        desc->AddMwCASTarget(&(target_fields_[i]), Target{0}, Target{1});
+      }
+      EXPECT_TRUE(desc->MwCAS());
+      mwcas_finished.set_value();
+      can_exit.get_future().wait();
+    }};
+    mwcas_finished.get_future().wait();
+
+    // a finalizer should release target words within two intervals
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+    for (size_t i = 0; i < kMwCASCapacity; ++i) {
+      while (LoadRawWord(i) != Target{1} && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::microseconds{kFinalizeInterval});
+      }
+      EXPECT_EQ(Target{1}, LoadRawWord(i));
+    }
+
+    can_exit.set_value();
+    worker.join();
+  }
+
+  void
+  VerifyNonHelpingRead(const size_t thread_num)
+  {
+    std::atomic_bool is_running{true};
+
+    // target fields are only incremented, so read values must not decrease
+    std::thread reader{[&]() {
+      std::vector<Target> prev_vals(kTargetFieldNum, 0);
+      while (is_running.load(std::memory_order_relaxed)) {
+        for (size_t i = 0; i < kTargetFieldNum; ++i) {
+          auto *addr = &(target_fields_[i]);
+          const auto val = AOPTDescriptor<>::Read<Target, ReadPolicy::NON_HELPING>(addr);
+          EXPECT_LE(prev_vals[i], val);
+          prev_vals[i] = val;
+        }
+      }
+    }};
+
+    VerifyMwCAS(thread_num);
+
+    is_running.store(false, std::memory_order_relaxed);
+    reader.join();
+  }
+
+  template <bool kUseRDCSS, size_t kWordNum>
+  void
+  VerifyNonHelpingReadWithChangedCompareTarget(  //
+      std::integral_constant<size_t, kWordNum>,
+      const size_t thread_num)
+  {
+    // writers increment a target only if a flag is even, and the flag is incremented
+    auto *flag = &(target_fields_[0]);
+    auto *addr = &(target_fields_[1]);
+    std::atomic_bool is_running{true};
+    auto write = [&]() {
+      while (is_running.load(std::memory_order_relaxed)) {
+        const AOPTDescriptor<>::Session session{};
+        const auto cur_flag = AOPTDescriptor<>::Read<Target>(flag, session);
+        if (cur_flag % 2 == 1) continue;
+
+        const auto cur_val = AOPTDescriptor<>::Read<Target>(addr, session);
+        if constexpr (kUseRDCSS) {
+          RDCSS(session, CompareTarget{flag, cur_flag}, MwCASTarget{addr, cur_val, cur_val + 1});
+        } else {
+          auto *desc = AOPTDescriptor<>::GetDescriptor();
+          desc->AddCompareTarget(flag, cur_flag);
+          desc->AddMwCASTarget(addr, cur_val, cur_val + 1);
+          desc->MwCAS(session);
+        }
+      }
+    };
+
+    // the target must not be changed while readers observe the same odd flag
+    auto read = [&]() {
+      while (is_running.load(std::memory_order_relaxed)) {
+        const AOPTDescriptor<>::Session session{};
+        const auto first_flag = NonHelpingRead(flag, session);
+        if (first_flag % 2 == 0) continue;
+
+        const auto first_val = NonHelpingRead(addr, session);
+        const auto second_val = NonHelpingRead(addr, session);
+        if (NonHelpingRead(flag, session) == first_flag) {
+          EXPECT_EQ(first_val, second_val);
+        }
+      }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < thread_num; ++i) {
+      if (i % 2 == 0) {
+        threads.emplace_back(write);
+      } else {
+        threads.emplace_back(read);
+      }
+    }
+    for (size_t i = 0; i < kExecNum / 10; ++i) {
+      const auto cur_flag = AOPTDescriptor<>::Read<Target>(flag);
+      EXPECT_TRUE(MwCAS(MwCASTarget{flag, cur_flag, cur_flag + 1}));
+    }
+    is_running.store(false, std::memory_order_relaxed);
+    for (auto &&t : threads) t.join();
   }
 
  private:
@@ -86,12 +986,140 @@ class AOPTDescriptorFixture : public ::testing::Test
   using Target = uint64_t;
   using MwCASTargets = std::vector<size_t>;
 
+  /*################################################################################################
+   * Internal classes
+   *##############################################################################################*/
+
+  /**
+   * @brief A contention manager to hold threads at their first active descriptors.
+   *
+   */
+  class GateCM
+  {
+   public:
+    static auto
+    OnActiveDescriptor()  //
+        -> bool
+    {
+      blocked_num_.fetch_add(1, std::memory_order_acq_rel);
+      while (!is_open_.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+      }
+      return true;
+    }
+
+    static constexpr void
+    OnEmbedFailure()
+    {
+    }
+
+    static void
+    Close()
+    {
+      blocked_num_.store(0, std::memory_order_relaxed);
+      is_open_.store(false, std::memory_order_release);
+    }
+
+    static void
+    WaitFor(const size_t thread_num)
+    {
+      while (blocked_num_.load(std::memory_order_acquire) < thread_num) {
+        std::this_thread::yield();
+      }
+    }
+
+    static void
+    Open()
+    {
+      is_open_.store(true, std::memory_order_release);
+    }
+
+   private:
+    static inline std::atomic_size_t blocked_num_{0};
+
+    static inline std::atomic_bool is_open_{false};
+  };
+
   /*################################################################################################
    * Internal utility functions
    *##############################################################################################*/
 
+  auto
+  LoadRawWord(const size_t idx)  //
+      -> Target
+  {
+    auto *addr = reinterpret_cast<std::atomic<Target> *>(&(target_fields_[idx]));
+    return addr->load(std::memory_order_acquire);
+  }
+
+  static auto
+  NonHelpingRead(  //
+      void *addr,
+      const AOPTDescriptor<>::Session &session)  //
+      -> Target
+  {
+    return AOPTDescriptor<>::Read<Target, ReadPolicy::NON_HELPING>(addr, session);
+  }
+
+  /**
+   * @brief Occupy given words by a descriptor whose owner seems to have stopped.
+   *
+   * The descriptor does not change the words, and a thread that helps it finishes it.
+   *
+   * @param words target words to be occupied.
+   */
+  static void
+  StallWords(const std::array<Target *, 2> &words)
+  {
+    auto *desc = AOPTDescriptor<>::GetDescriptor();
+    for (auto *word : words) {
+      desc->AddMwCASTarget(word, Target{0}, Target{0});
+    }
+    for (size_t i = 0; i < words.size(); ++i) {
+      EmbedWord(desc, i, words[i]);
+    }
+  }
+
+  /**
+   * @brief Embed a word descriptor into its target word as an owner does.
+   *
+   * @param desc a descriptor that contains the word descriptor.
+   * @param pos the position of the word descriptor.
+   * @param word the target word of the word descriptor.
+   */
+  static void
+  EmbedWord(  //
+      void *desc,
+      const size_t pos,
+      Target *word)
+  {
+    auto *word_desc = static_cast<std::byte *>(desc) + component::kDescriptorHeaderSize
+                      + pos * sizeof(component::WordDescriptor);
+    *reinterpret_cast<component::MwCASField *>(word) = component::MwCASField{word_desc, true};
+  }
+
+  /**
+   * @tparam kUseSession a flag to perform each MwCAS attempt in a session.
+   * @param capacity the capacity of descriptors.
+   * @return a worker function that uses descriptors with a given capacity.
+   */
+  template <bool kUseSession>
+  static auto
+  GetWorker(const size_t capacity)  //
+      -> void (AOPTDescriptorFixture::*)(size_t)
+  {
+    if (capacity == 1) return &AOPTDescriptorFixture::MwCASRandomly<1, kUseSession>;
+    if (capacity == kSmallCapacity) {
+      return &AOPTDescriptorFixture::MwCASRandomly<kSmallCapacity, kUseSession>;
+    }
+    return &AOPTDescriptorFixture::MwCASRandomly<kMwCASCapacity, kUseSession>;
+  }
+
   void
-  RunMwCAS(const size_t thread_num)
+  RunMwCAS(  //
+      const size_t thread_num,
+      const size_t sub_capacity,
+      const bool use_session)
   {
     std::vector<std::thread> threads;
 
@@ -102,7 +1130,10 @@ class AOPTDescriptorFixture : public ::testing::Test
       std::mt19937_64 rand_engine(kRandomSeed);
       for (size_t i = 0; i < thread_num; ++i) {
         const auto rand_seed = rand_engine();
-        threads.emplace_back(&AOPTDescriptorFixture::MwCASRandomly, this, rand_seed);
+        const auto capacity = (i % 2 == 1) ? sub_capacity : kMwCASCapacity;
+        const auto worker = (use_session) ? GetWorker<true>(capacity)  //
+                                          : GetWorker<false>(capacity);
+        threads.emplace_back(worker, this, rand_seed);
       }
 
       // wait for all workers to finish initialization
@@ -114,6 +1145,7 @@ class AOPTDescriptorFixture : public ::testing::Test
     for (auto &&t : threads) t.join();
   }
 
+  template <size_t kCapacity, bool kUseSession>
   void
   MwCASRandomly(const size_t rand_seed)
   {
@@ -128,15 +1160,14 @@ class AOPTDescriptorFixture : public ::testing::Test
       for (size_t i = 0; i < kExecNum; ++i) {
         // select MwCAS target fields randomly
         MwCASTargets targets;
-        targets.reserve(kMwCASCapacity);
-        while (targets.size() < kMwCASCapacity) {
+        targets.reserve(kCapacity);
+        while (targets.size() < kCapacity) {
           size_t idx = id_dist_(rand_engine);
           const auto iter = std::find(targets.begin(), targets.end(), idx);
           if (iter == targets.end()) {
             targets.emplace_back(idx);
           }
         }
-        std::sort(targets.begin(), targets.end());
 
         // add a new targets
         operations.emplace_back(std::move(targets));
@@ -149,28 +1180,55 @@ class AOPTDescriptorFixture : public ::testing::Test
       for (auto &&targets : operations) {
         // retry until MwCAS succeeds
         while (true) {
-          // register MwCAS targets
-          auto *desc = AOPTDescriptor::GetDescriptor();
-          for (auto &&idx : targets) {
-            auto *addr = &(target_fields_[idx]);
-            const auto cur_val = AOPTDescriptor::Read<Target>(addr);
-            const auto new_val = cur_val + 1;
-            desc->AddMwCASTarget(addr, cur_val, new_val);
+          if constexpr (kUseSession) {
+            const AOPTDescriptor<>::Session session{};
+            if (TryMwCAS<kCapacity>(targets, session)) break;
+          } else {
+            if (TryMwCAS<kCapacity>(targets)) break;
           }
-
-          // perform MwCAS
-          if (desc->MwCAS()) break;
         }
       }
     }
   }
 
+  /**
+   * @brief Increment given targets by MwCAS.
+   *
+   * @tparam kCapacity the capacity of descriptors.
+   * @tparam Session an optional session class.
+   * @param targets the indices of target fields.
+   * @param session an optional session for all the operations.
+   * @retval true if MwCAS succeeds.
+   * @retval false otherwise.
+   */
+  template <size_t kCapacity, class... Session>
+  auto
+  TryMwCAS(  //
+      const MwCASTargets &targets,
+      const Session &...session)  //
+      -> bool
+  {
+    // register MwCAS targets
+    auto *desc = AOPTDescriptor<kCapacity>::GetDescriptor();
+    for (auto &&idx : targets) {
+      auto *addr = &(target_fields_[idx]);
+      const auto cur_val = AOPTDescriptor<>::Read<Target>(addr, session...);
+      const auto new_val = cur_val + 1;
+      desc->AddMwCASTarget(addr, cur_val, new_val);
+    }
+
+    // perform MwCAS
+    return desc->MwCAS(session...);
+  }
+
   /*################################################################################################
    * Internal member variables
    *##############################################################################################*/
 
   Target target_fields_[kTargetFieldNum]{};
 
+  MyWideClass wide_field_{0, 0, 0};
+
   std::uniform_int_distribution<size_t> id_dist_{0, kMwCASCapacity - 1};
 
   std::shared_mutex main_lock_{};
@@ -181,6 +1239,164 @@ class AOPTDescriptorFixture : public ::testing::Test
  * Public utility tests
  *------------------------------------------------------------------------------------------------*/
 
+TEST_F(AOPTDescriptorFixture, GetDescriptorWithSmallCapacityFitInFewCacheLines)
+{
+  // a descriptor header and word descriptors are packed
+  EXPECT_LE(sizeof(AOPTDescriptor<2>), component::kCacheLineSize);
+  if constexpr (kMwCASCapacity >= 4) {
+    EXPECT_LE(sizeof(AOPTDescriptor<4>), 2 * component::kCacheLineSize);
+  }
+}
+
+TEST_F(AOPTDescriptorFixture, GetDescriptorReturnDescriptorAlignedToPage)
+{
+  // descriptors cannot be constructed outside descriptor pools
+  EXPECT_FALSE((std::is_constructible_v<AOPTDescriptor<>, size_t>));
+  VerifyPageAlignment();
+}
+
+TEST_F(AOPTDescriptorFixture, AddMwCASTargetWithDuplicateAddressFail)
+{  //
+  VerifyAddMwCASTarget();
+}
+
+TEST_F(AOPTDescriptorFixture, MwCASWithUnexpectedValueReportMismatchedWord)
+{  //
+  VerifyMwCASResult();
+}
+
+TEST_F(AOPTDescriptorFixture, MwCASWithStaleValueRecycleDescriptorIfPreValidated)
+{
+  if constexpr (!kUsePreValidation) GTEST_SKIP();
+  VerifyPreValidation();
+}
+
+TEST_F(AOPTDescriptorFixture, MwCASWithUnexpectedFirstWordRecycleDescriptor)
+{
+  if constexpr (!kSortTargets) GTEST_SKIP() << "targets are installed in registration order";
+  VerifyUnpublishedFailure();
+}
+
+TEST_F(AOPTDescriptorFixture, MwCASWithCompareTargetValidateThemWithoutInstallation)
+{
+  if constexpr (kMwCASCapacity < 2) GTEST_SKIP();
+  VerifyCompareTarget();
+}
+
+TEST_F(AOPTDescriptorFixture, MwCASWithCompareTargetsObserveConsistentSnapshots)
+{
+  if constexpr (kMwCASCapacity < 3) GTEST_SKIP();
+  VerifyCompareTargetsWithTransfers(kThreadNum);
+}
+
+TEST_F(AOPTDescriptorFixture, MwCASWithCrossedCompareTargetsSucceedOnlyOnce)
+{
+  RunIfCapacityAllows<3>([&](auto word_num) {
+    VerifyCrossedCompareTargets(word_num, false);
+    VerifyCrossedCompareTargets(word_num, true);
+  });
+}
+
+TEST_F(AOPTDescriptorFixture, MwCASWithWideTargetUpdateBothWordsAtOnce)
+{
+  if constexpr (kMwCASCapacity < 2) GTEST_SKIP();
+  VerifyWideTarget();
+}
+
+TEST_F(AOPTDescriptorFixture, MwCASWithWideTargetsCorrectlyIncrementTargets)
+{
+  if constexpr (kMwCASCapacity < 3) GTEST_SKIP();
+  VerifyWideTargetWithMultiThreads(kThreadNum);
+}
+
+TEST_F(AOPTDescriptorFixture, MwCASWithFixedTargetsUpdateThemInAddressOrder)
+{  //
+  RunIfCapacityAllows<2>([&](auto word_num) { VerifyFixedTargets(word_num); });
+}
+
+TEST_F(AOPTDescriptorFixture, MwCASWithFixedWideTargetUpdateBothTargets)
+{  //
+  RunIfCapacityAllows<3>([&](auto word_num) { VerifyFixedTargetsWithWideTarget(word_num); });
+}
+
+TEST_F(AOPTDescriptorFixture, MwCASWithTwoFixedTargetsCorrectlyIncrementTargets)
+{  //
+  RunIfCapacityAllows<2>(
+      [&](auto word_num) { VerifyFixedTargetsWithMultiThreads(word_num, kThreadNum); });
+}
+
+TEST_F(AOPTDescriptorFixture, MwCASWithThreeFixedTargetsCorrectlyIncrementTargets)
+{  //
+  RunIfCapacityAllows<3>(
+      [&](auto word_num) { VerifyFixedTargetsWithMultiThreads(word_num, kThreadNum); });
+}
+
+TEST_F(AOPTDescriptorFixture, RDCSSWithChangedControlWordFailWithoutWritingTarget)
+{  //
+  RunIfCapacityAllows<2>([&](auto word_num) { VerifyRDCSS(word_num); });
+}
+
+TEST_F(AOPTDescriptorFixture, RDCSSWithCrossedControlWordsSucceedOnlyOnce)
+{
+  RunIfCapacityAllows<2>([&](auto word_num) {
+    VerifyCrossedRDCSS(word_num, false);
+    VerifyCrossedRDCSS(word_num, true);
+  });
+}
+
+TEST_F(AOPTDescriptorFixture, RDCSSWithMultiThreadsCorrectlyIncrementTarget)
+{  //
+  RunIfCapacityAllows<2>([&](auto word_num) { VerifyRDCSSWithMultiThreads(word_num, kThreadNum); });
+}
+
+TEST_F(AOPTDescriptorFixture, MwCASUpdateWithUnpublishedFailureReuseDescriptor)
+{  //
+  VerifyMwCASUpdate();
+}
+
+TEST_F(AOPTDescriptorFixture, MwCASUpdateWithMultiThreadsCorrectlyIncrementTargets)
+{  //
+  VerifyMwCASUpdateWithMultiThreads(kThreadNum);
+}
+
+TEST_F(AOPTDescriptorFixture, ReadSnapshotReturnValuesWithoutDescriptors)
+{  //
+  VerifyReadSnapshot();
+}
+
+TEST_F(AOPTDescriptorFixture, ReadSnapshotDuringMwCASReturnConsistentValues)
+{
+  if constexpr (kMwCASCapacity < 2) GTEST_SKIP();
+  VerifyReadSnapshotWithTransfers(kThreadNum);
+}
+
+TEST_F(AOPTDescriptorFixture, ReadRangeReturnValuesOfContiguousWords)
+{  //
+  VerifyReadRange();
+}
+
+TEST_F(AOPTDescriptorFixture, ReadRangeFromUnalignedAddressReturnValuesOfContiguousWords)
+{  //
+  VerifyReadRangeFromEachOffset();
+}
+
+TEST_F(AOPTDescriptorFixture, ReadRangeDuringMwCASReturnMonotonicValues)
+{
+  VerifyReadRangeDuringMwCAS(kThreadNum);
+}
+
+TEST_F(AOPTDescriptorFixture, FlushFinishedDescriptorsAfterMwCASReleaseTargetWords)
+{
+  if constexpr (kMwCASCapacity == 1) GTEST_SKIP();  // single-word CAS is not finalized
+  VerifyFlushFinishedDescriptors();
+}
+
+TEST_F(AOPTDescriptorFixture, MwCASWithIdleThreadFinalizedInBackground)
+{
+  if constexpr (kFinalizeInterval == 0 || kMwCASCapacity == 1) GTEST_SKIP();
+  VerifyBackgroundFinalization();
+}
+
 TEST_F(AOPTDescriptorFixture, MwCASWithSingleThreadCorrectlyIncrementTargets)
 {  //
   VerifyMwCAS(1);
@@ -191,4 +1407,38 @@ TEST_F(AOPTDescriptorFixture, MwCASWithMultiThreadsCorrectlyIncrementTargets)
   VerifyMwCAS(kThreadNum);
 }
 
+TEST_F(AOPTDescriptorFixture, MwCASWithMixedCapacitiesCorrectlyIncrementTargets)
+{
+  VerifyMwCAS(kThreadNum, kSmallCapacity);
+}
+
+TEST_F(AOPTDescriptorFixture, MwCASWithSingleWordCASCorrectlyIncrementTargets)
+{  //
+  VerifyMwCAS(kThreadNum, 1);
+}
+
+TEST_F(AOPTDescriptorFixture, MwCASWithSessionsCorrectlyIncrementTargets)
+{  //
+  VerifyMwCAS(kThreadNum, kMwCASCapacity, true);
+}
+
+TEST_F(AOPTDescriptorFixture, NonHelpingReadDuringMwCASReturnMonotonicValues)
+{
+  VerifyNonHelpingRead(kThreadNum);
+}
+
+TEST_F(AOPTDescriptorFixture, NonHelpingReadWithChangedCompareTargetReturnLinearizableValues)
+{
+  RunIfCapacityAllows<2>([&](auto word_num) {
+    VerifyNonHelpingReadWithChangedCompareTarget<false>(word_num, kThreadNum);
+  });
+}
+
+TEST_F(AOPTDescriptorFixture, NonHelpingReadWithChangedControlWordReturnLinearizableValues)
+{
+  RunIfCapacityAllows<2>([&](auto word_num) {
+    VerifyNonHelpingReadWithChangedCompareTarget<true>(word_num, kThreadNum);
+  });
+}
+
 }  // namespace dbgroup::atomic::aopt::test
@@ -0,0 +1,304 @@
+/*
+ * Copyright 2021 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "aopt/aopt_range_descriptor.hpp"
+
+#include <array>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "aopt/aopt_descriptor.hpp"
+#include "common.hpp"
+#include "gtest/gtest.h"
+
+namespace dbgroup::atomic::aopt::test
+{
+class AOPTRangeDescriptorFixture : public ::testing::Test
+{
+ protected:
+  /*################################################################################################
+   * Internal type aliases
+   *##############################################################################################*/
+
+  using Target = uint64_t;
+  using RangeDescriptor = AOPTRangeDescriptor<>;
+
+  /*################################################################################################
+   * Internal constants
+   *##############################################################################################*/
+
+  static constexpr size_t kFieldNum = RangeDescriptor::kCapacity;
+  static constexpr size_t kExecNum = 1e4;
+
+  /*################################################################################################
+   * Setup/Teardown
+   *##############################################################################################*/
+
+  void
+  SetUp() override
+  {
+    fields_.fill(0);
+    RangeDescriptor::StartGC();
+  }
+
+  void
+  TearDown() override
+  {
+    RangeDescriptor::StopGC();
+  }
+
+  /*################################################################################################
+   * Functions for verification
+   *##############################################################################################*/
+
+  void
+  VerifySetMwCASRange()
+  {
+    RunInWorker([&]() {
+      std::array<Target, kFieldNum + 1> old_vals{};
+      std::array<Target, kFieldNum + 1> new_vals{};
+      new_vals.fill(1);
+
+      auto *desc = RangeDescriptor::GetDescriptor();
+      EXPECT_FALSE(desc->SetMwCASRange(fields_.data(), old_vals.data(), new_vals.data(), 0));
+      EXPECT_FALSE(desc->SetMwCASRange(fields_.data(), old_vals.data(), new_vals.data(),
+                                       kFieldNum + 1));
+      EXPECT_EQ(0, desc->Size());
+
+      EXPECT_TRUE(desc->SetMwCASRange(fields_.data(), old_vals.data(), new_vals.data(), kFieldNum));
+      EXPECT_EQ(kFieldNum, desc->Size());
+      EXPECT_TRUE(desc->MwCAS());
+      for (size_t i = 0; i < kFieldNum; ++i) {
+        EXPECT_EQ(1, RangeDescriptor::Read<Target>(&(fields_[i])));
+      }
+    });
+  }
+
+  void
+  VerifyShiftRange()
+  {
+    for (size_t i = 0; i < kFieldNum; ++i) {
+      fields_[i] = i;
+    }
+
+    RunInWorker([&]() {
+      // shift all the words to the right and insert a new value into the first one
+      constexpr Target kInserted = 100;
+      std::array<Target, kFieldNum> old_vals{};
+      std::array<Target, kFieldNum> new_vals{};
+      RangeDescriptor::ReadRange(fields_.data(), kFieldNum, old_vals.data());
+      new_vals[0] = kInserted;
+      for (size_t i = 1; i < kFieldNum; ++i) {
+        new_vals[i] = old_vals[i - 1];
+      }
+
+      auto *desc = RangeDescriptor::GetDescriptor();
+      desc->SetMwCASRange(fields_.data(), old_vals.data(), new_vals.data(), kFieldNum);
+      EXPECT_TRUE(desc->MwCAS());
+
+      // target words are read via normal functions regardless of descriptors in them
+      EXPECT_EQ(kInserted, RangeDescriptor::Read<Target>(&(fields_[0])));
+      for (size_t i = 1; i < kFieldNum; ++i) {
+        EXPECT_EQ(i - 1, RangeDescriptor::Read<Target>(&(fields_[i])));
+      }
+
+      // finalization writes the new values back into the target words
+      RangeDescriptor::FlushFinishedDescriptors();
+      for (size_t i = 0; i < kFieldNum; ++i) {
+        EXPECT_EQ(new_vals[i], fields_[i]);
+      }
+    });
+  }
+
+  void
+  VerifyMwCASResult()
+  {
+    RunInWorker([&]() {
+      constexpr Target kUnexpected = 10;
+      auto *failed_addr = &(fields_[kFieldNum - 1]);
+      *failed_addr = kUnexpected;
+
+      std::array<Target, kFieldNum> old_vals{};
+      std::array<Target, kFieldNum> new_vals{};
+      new_vals.fill(1);
+
+      auto *desc = RangeDescriptor::GetDescriptor();
+      desc->SetMwCASRange(fields_.data(), old_vals.data(), new_vals.data(), kFieldNum);
+      RangeDescriptor::MwCASResult failed{};
+      EXPECT_FALSE(desc->MwCAS(failed));
+      EXPECT_EQ(failed_addr, failed.GetFailedAddress());
+      EXPECT_EQ(kUnexpected, failed.GetObservedValue<Target>());
+
+      // a failed MwCAS reverts all the target words
+      RangeDescriptor::FlushFinishedDescriptors();
+      for (size_t i = 0; i + 1 < kFieldNum; ++i) {
+        EXPECT_EQ(0, fields_[i]);
+      }
+      EXPECT_EQ(kUnexpected, *failed_addr);
+    });
+  }
+
+  void
+  VerifyMwCASWithEachLength()
+  {
+    RunInWorker([&]() {
+      std::array<Target, kFieldNum> old_vals{};
+      std::array<Target, kFieldNum> new_vals{};
+      std::array<Target, kFieldNum> stale_vals{};
+      for (size_t n = 1; n <= kFieldNum; ++n) {
+        RangeDescriptor::ReadRange(fields_.data(), n, old_vals.data());
+        for (size_t i = 0; i < n; ++i) {
+          new_vals[i] = old_vals[i] + 1;
+        }
+        auto *desc = RangeDescriptor::GetDescriptor();
+        EXPECT_TRUE(desc->SetMwCASRange(fields_.data(), old_vals.data(), new_vals.data(), n));
+        EXPECT_TRUE(desc->MwCAS());
+
+        // a MwCAS with stale values also releases extension pages
+        desc = RangeDescriptor::GetDescriptor();
+        desc->SetMwCASRange(fields_.data(), stale_vals.data(), new_vals.data(), n);
+        EXPECT_FALSE(desc->MwCAS());
+      }
+
+      // the i-th word is updated by ranges longer than i
+      RangeDescriptor::FlushFinishedDescriptors();
+      for (size_t i = 0; i < kFieldNum; ++i) {
+        EXPECT_EQ(kFieldNum - i, fields_[i]);
+      }
+    });
+  }
+
+  void
+  VerifyMwCASWithNormalDescriptors(const size_t thread_num)
+  {
+    constexpr size_t kOffsetNum = kFieldNum - kMwCASCapacity + 1;
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < thread_num; ++i) {
+      threads.emplace_back([&]() {
+        for (size_t j = 0; j < kExecNum; ++j) {
+          if (j % 2 == 0) {
+            IncrementRange();
+          } else {
+            IncrementWords(j % kOffsetNum);
+          }
+        }
+      });
+    }
+    for (auto &&t : threads) t.join();
+
+    size_t sum = 0;
+    for (size_t i = 0; i < kFieldNum; ++i) {
+      sum += RangeDescriptor::Read<Target>(&(fields_[i]));
+    }
+    const auto range_num = thread_num * ((kExecNum + 1) / 2);
+    const auto normal_num = thread_num * (kExecNum / 2);
+    EXPECT_EQ(range_num * kFieldNum + normal_num * kMwCASCapacity, sum);
+  }
+
+ private:
+  /*################################################################################################
+   * Internal utility functions
+   *##############################################################################################*/
+
+  void
+  IncrementRange()
+  {
+    std::array<Target, kFieldNum> old_vals{};
+    std::array<Target, kFieldNum> new_vals{};
+    while (true) {
+      const RangeDescriptor::Session session{};
+      RangeDescriptor::ReadRange(fields_.data(), kFieldNum, old_vals.data(), session);
+      for (size_t i = 0; i < kFieldNum; ++i) {
+        new_vals[i] = old_vals[i] + 1;
+      }
+
+      auto *desc = RangeDescriptor::GetDescriptor();
+      desc->SetMwCASRange(fields_.data(), old_vals.data(), new_vals.data(), kFieldNum);
+      if (desc->MwCAS(session)) return;
+    }
+  }
+
+  void
+  IncrementWords(const size_t offset)
+  {
+    while (true) {
+      const AOPTDescriptor<>::Session session{};
+      auto *desc = AOPTDescriptor<>::GetDescriptor();
+      for (size_t i = offset; i < offset + kMwCASCapacity; ++i) {
+        auto *addr = &(fields_[i]);
+        const auto cur_val = AOPTDescriptor<>::Read<Target>(addr, session);
+        desc->AddMwCASTarget(addr, cur_val, cur_val + 1);
+      }
+      if (desc->MwCAS(session)) return;
+    }
+  }
+
+  /*################################################################################################
+   * Internal member variables
+   *##############################################################################################*/
+
+  std::array<Target, kFieldNum> fields_{};
+};
+
+/*##################################################################################################
+ * Unit test definitions
+ *################################################################################################*/
+
+TEST_F(AOPTRangeDescriptorFixture, RangeDescriptorFitInDescriptorPage)
+{
+  EXPECT_GE(RangeDescriptor::kCapacity, kMwCASCapacity);
+  EXPECT_LE(sizeof(RangeDescriptor), component::kDescriptorPageSize);
+
+  // a range is not bounded by one page because of extension pages
+  EXPECT_GT(RangeDescriptor::kCapacity, component::kRangeWordsPerPage);
+
+  // descriptors cannot be constructed outside descriptor pools
+  EXPECT_FALSE((std::is_constructible_v<RangeDescriptor, size_t>));
+}
+
+TEST_F(AOPTRangeDescriptorFixture, SetMwCASRangeWithInvalidLengthFail)
+{  //
+  VerifySetMwCASRange();
+}
+
+TEST_F(AOPTRangeDescriptorFixture, MwCASWithRangeShiftContiguousWords)
+{  //
+  VerifyShiftRange();
+}
+
+TEST_F(AOPTRangeDescriptorFixture, MwCASWithUnexpectedValueReportMismatchedWord)
+{  //
+  VerifyMwCASResult();
+}
+
+TEST_F(AOPTRangeDescriptorFixture, MwCASWithEachLengthUpToCapacityUpdateTargets)
+{  //
+  VerifyMwCASWithEachLength();
+}
+
+TEST_F(AOPTRangeDescriptorFixture, MwCASWithSingleThreadCorrectlyIncrementTargets)
+{  //
+  VerifyMwCASWithNormalDescriptors(1);
+}
+
+TEST_F(AOPTRangeDescriptorFixture, MwCASWithMultiThreadsCorrectlyIncrementTargets)
+{  //
+  VerifyMwCASWithNormalDescriptors(kThreadNum);
+}
+
+}  // namespace dbgroup::atomic::aopt::test
@@ -18,8 +18,12 @@
 #define MWCAS_AOPT_TEST_COMMON_H_
 
 #include <functional>
+#include <thread>
+#include <type_traits>
+#include <utility>
 
 #include "aopt/utility.hpp"
+#include "gtest/gtest.h"
 
 #ifdef MWCAS_AOPT_TEST_THREAD_NUM
 constexpr size_t kThreadNum = MWCAS_AOPT_TEST_THREAD_NUM;
@@ -64,6 +68,28 @@ struct MyClass {
   }
 };
 
+/**
+ * @brief An example class to represent double-width CAS-updatable data.
+ *
+ */
+struct alignas(16) MyWideClass {
+  uint64_t data : 63;
+  uint64_t control_bits : 1;
+  uint64_t version;
+
+  constexpr bool
+  operator==(const MyWideClass &comp) const
+  {
+    return data == comp.data && version == comp.version;
+  }
+
+  constexpr bool
+  operator!=(const MyWideClass &comp) const
+  {
+    return !(*this == comp);
+  }
+};
+
 namespace dbgroup::atomic::aopt
 {
 /**
@@ -77,6 +103,60 @@ CanMwCAS<MyClass>()
   return true;
 }
 
+/**
+ * @brief Specialization to enable MwCAS to swap our sample double-width class.
+ *
+ */
+template <>
+constexpr bool
+CanMwCAS<MyWideClass>()
+{
+  return true;
+}
+
 }  // namespace dbgroup::atomic::aopt
 
+/*##################################################################################################
+ * Utility functions for unit tests
+ *################################################################################################*/
+
+/**
+ * @brief Run a given function in a new thread and wait for it.
+ *
+ * A thread finalizes its descriptors at its exit, and so a test can stop GC after this
+ * function without leaving descriptors in target words.
+ *
+ * @tparam Func a class of a function.
+ * @param func a function to be run.
+ */
+template <class Func>
+void
+RunInWorker(Func &&func)
+{
+  std::thread worker{std::forward<Func>(func)};
+  worker.join();
+}
+
+/**
+ * @brief Run a given function only if descriptors can contain a given number of words.
+ *
+ * The function receives the number as std::integral_constant, and so a test that uses
+ * descriptors with the number as their capacity is not instantiated for a smaller
+ * MWCAS_AOPT_MWCAS_CAPACITY.
+ *
+ * @tparam kWordNum the number of target words used by a test.
+ * @tparam Func a class of a function.
+ * @param func a function to be run.
+ */
+template <size_t kWordNum, class Func>
+void
+RunIfCapacityAllows(Func &&func)
+{
+  if constexpr (kWordNum > ::dbgroup::atomic::aopt::kMwCASCapacity) {
+    GTEST_SKIP() << "the capacity is less than the number of target words";
+  } else {
+    func(std::integral_constant<size_t, kWordNum>{});
+  }
+}
+
 #endif  // MWCAS_AOPT_TEST_COMMON_H_
@@ -0,0 +1,151 @@
+/*
+ * Copyright 2021 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "aopt/contention_manager.hpp"
+
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "aopt/aopt_descriptor.hpp"
+#include "common.hpp"
+#include "gtest/gtest.h"
+
+namespace dbgroup::atomic::aopt::test
+{
+template <class ContentionManager>
+class ContentionManagerFixture : public ::testing::Test
+{
+ protected:
+  /*################################################################################################
+   * Internal type aliases
+   *##############################################################################################*/
+
+  using Descriptor = AOPTDescriptor<kMwCASCapacity, ContentionManager>;
+  using Target = uint64_t;
+
+  /*################################################################################################
+   * Setup/Teardown
+   *##############################################################################################*/
+
+  void
+  SetUp() override
+  {
+    Descriptor::StartGC();
+  }
+
+  void
+  TearDown() override
+  {
+    Descriptor::StopGC();
+  }
+
+  /*################################################################################################
+   * Functions for verification
+   *##############################################################################################*/
+
+  void
+  VerifyOnActiveDescriptorEventuallyHelp()
+  {
+    ContentionManager cm{};
+    size_t wait_num = 0;
+    while (!cm.OnActiveDescriptor()) {
+      ASSERT_LT(++wait_num, kMaxWaitNum);
+    }
+  }
+
+  void
+  VerifyMwCASOnHotWords()
+  {
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < kThreadNum; ++i) {
+      threads.emplace_back(&ContentionManagerFixture::IncrementRandomly, this, i);
+    }
+    for (auto &&t : threads) t.join();
+
+    size_t sum = 0;
+    for (auto &&target : target_fields_) {
+      sum += target;
+    }
+    EXPECT_EQ(kThreadNum * kExecNum * kMwCASCapacity, sum);
+  }
+
+ private:
+  /*################################################################################################
+   * Internal constants
+   *##############################################################################################*/
+
+  static constexpr size_t kExecNum = 1e5;
+  static constexpr size_t kMaxWaitNum = 64;
+  static constexpr size_t kTargetFieldNum = kMwCASCapacity + 1;
+
+  /*################################################################################################
+   * Internal utility functions
+   *##############################################################################################*/
+
+  void
+  IncrementRandomly(const size_t rand_seed)
+  {
+    std::mt19937_64 rand_engine{rand_seed};
+    std::uniform_int_distribution<size_t> skip_dist{0, kMwCASCapacity};
+
+    for (size_t i = 0; i < kExecNum; ++i) {
+      // update all the hot words except for a random one
+      const auto skipped = skip_dist(rand_engine);
+      while (true) {
+        auto *desc = Descriptor::GetDescriptor();
+        for (size_t j = 0; j < kTargetFieldNum; ++j) {
+          if (j == skipped) continue;
+          auto *addr = &(target_fields_[j]);
+          const auto cur_val = Descriptor::template Read<Target>(addr);
+          desc->AddMwCASTarget(addr, cur_val, cur_val + 1);
+        }
+        if (desc->MwCAS()) break;
+      }
+    }
+  }
+
+  /*################################################################################################
+   * Internal member variables
+   *##############################################################################################*/
+
+  Target target_fields_[kTargetFieldNum]{};
+};
+
+/*##################################################################################################
+ * Preparation for typed testing
+ *################################################################################################*/
+
+using ContentionManagers = ::testing::Types<EagerHelping,  //
+                                            ExponentialBackoff<>,
+                                            RandomizedHelping<>>;
+TYPED_TEST_SUITE(ContentionManagerFixture, ContentionManagers);
+
+/*##################################################################################################
+ * Unit test definitions
+ *################################################################################################*/
+
+TYPED_TEST(ContentionManagerFixture, OnActiveDescriptorRepeatedlyEventuallyDecideToHelp)
+{
+  TestFixture::VerifyOnActiveDescriptorEventuallyHelp();
+}
+
+TYPED_TEST(ContentionManagerFixture, MwCASOnHotWordsCorrectlyIncrementTargets)
+{
+  TestFixture::VerifyMwCASOnHotWords();
+}
+
+}  // namespace dbgroup::atomic::aopt::test
@@ -0,0 +1,190 @@
+/*
+ * Copyright 2021 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "aopt/component/descriptor_pool.hpp"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "common.hpp"
+#include "gtest/gtest.h"
+
+namespace dbgroup::atomic::aopt::component::test
+{
+/**
+ * @brief A dummy descriptor to be cached.
+ *
+ */
+struct alignas(kCacheLineSize) DummyDescriptor {
+  uint64_t data{0};
+};
+
+/**
+ * @brief A dummy GC to provide reclaimed pages.
+ *
+ */
+class DummyGC
+{
+ public:
+  ~DummyGC()
+  {
+    for (auto *page : pages_) {
+      FreeOnNode<sizeof(DummyDescriptor)>(page);
+    }
+  }
+
+  template <class T>
+  auto
+  GetPageIfPossible()  //
+      -> void *
+  {
+    if (pages_.empty()) return nullptr;
+
+    auto *page = pages_.back();
+    pages_.pop_back();
+    return page;
+  }
+
+  void
+  AddPage()
+  {
+    pages_.emplace_back(AllocateOnNode<sizeof(DummyDescriptor)>());
+  }
+
+  [[nodiscard]] auto
+  Size() const  //
+      -> size_t
+  {
+    return pages_.size();
+  }
+
+ private:
+  std::vector<void *> pages_{};
+};
+
+class DescriptorPoolFixture : public ::testing::Test
+{
+ protected:
+  /*################################################################################################
+   * Internal type aliases
+   *##############################################################################################*/
+
+  using Pool_t = DescriptorPool<DummyDescriptor>;
+
+  /*################################################################################################
+   * Setup/Teardown
+   *##############################################################################################*/
+
+  void
+  SetUp() override
+  {
+    pool_ = std::make_unique<Pool_t>();
+  }
+
+  void
+  TearDown() override
+  {
+    pool_.reset(nullptr);
+  }
+
+  /*################################################################################################
+   * Functions for verification
+   *##############################################################################################*/
+
+  void
+  VerifyGetPullsReclaimedPagesInBulk()
+  {
+    for (size_t i = 0; i < kDescriptorPoolCapacity; ++i) {
+      gc_.AddPage();
+    }
+    const auto before = Pool_t::GetStatistics();
+
+    auto *desc = new (pool_->Get(&gc_)) DummyDescriptor{};
+
+    // a half of the capacity is pulled at once
+    EXPECT_EQ(kDescriptorPoolCapacity / 2, gc_.Size());
+    const auto after = Pool_t::GetStatistics();
+    EXPECT_EQ(before.reuse_num + (kDescriptorPoolCapacity + 1) / 2, after.reuse_num);
+    EXPECT_EQ(before.alloc_num, after.alloc_num);
+
+    pool_->Release(desc);
+  }
+
+  void
+  VerifyReleasedDescriptorsAreReused()
+  {
+    // the GC has no pages, so the global allocator is used
+    auto *desc = new (pool_->Get(&gc_)) DummyDescriptor{};
+    pool_->Release(desc);
+
+    // the released page should be reused
+    auto *reused = new (pool_->Get(&gc_)) DummyDescriptor{};
+    EXPECT_EQ(desc, reused);
+    pool_->Release(reused);
+  }
+
+  void
+  VerifySurplusPagesAreSharedInNode()
+  {
+    // an exited thread passes its cached pages to the shared pool of its node
+    void *page{};
+    std::thread{[&]() {
+      Pool_t pool{};
+      page = pool.Get(&gc_);
+      pool.Release(new (page) DummyDescriptor{});
+    }}.join();
+    const auto before = Pool_t::GetStatistics();
+
+    // the GC has no pages, so the shared pages are reused instead of allocation
+    auto *desc = new (pool_->Get(&gc_)) DummyDescriptor{};
+    const auto after = Pool_t::GetStatistics();
+    EXPECT_LT(before.node_reuse_num, after.node_reuse_num);
+    EXPECT_EQ(before.alloc_num, after.alloc_num);
+    EXPECT_EQ(before.remote_num, after.remote_num);
+
+    pool_->Release(desc);
+  }
+
+  /*################################################################################################
+   * Internal member variables
+   *##############################################################################################*/
+
+  DummyGC gc_{};
+
+  std::unique_ptr<Pool_t> pool_{};
+};
+
+/*--------------------------------------------------------------------------------------------------
+ * Public utility tests
+ *------------------------------------------------------------------------------------------------*/
+
+TEST_F(DescriptorPoolFixture, GetWithEmptyPoolPullReclaimedPagesInBulk)
+{  //
+  VerifyGetPullsReclaimedPagesInBulk();
+}
+
+TEST_F(DescriptorPoolFixture, GetAfterReleaseReuseReleasedDescriptor)
+{  //
+  VerifyReleasedDescriptorsAreReused();
+}
+
+TEST_F(DescriptorPoolFixture, GetAfterThreadExitReuseSurplusPagesInSameNode)
+{  //
+  VerifySurplusPagesAreSharedInNode();
+}
+
+}  // namespace dbgroup::atomic::aopt::component::test
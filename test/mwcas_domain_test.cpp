@@ -0,0 +1,247 @@
+/*
+ * Copyright 2021 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// this test always counts events regardless of build options
+#ifndef MWCAS_AOPT_ENABLE_STATISTICS
+#define MWCAS_AOPT_ENABLE_STATISTICS
+#endif
+
+#include "aopt/mwcas_domain.hpp"
+
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "common.hpp"
+#include "gtest/gtest.h"
+
+namespace dbgroup::atomic::aopt::test
+{
+class MwCASDomainFixture : public ::testing::Test
+{
+ protected:
+  /*################################################################################################
+   * Internal type aliases
+   *##############################################################################################*/
+
+  using Target = uint64_t;
+
+  /*################################################################################################
+   * Internal constants
+   *##############################################################################################*/
+
+  static constexpr size_t kExecNum = 1e4;
+
+  /*################################################################################################
+   * Functions for verification
+   *##############################################################################################*/
+
+  void
+  VerifyMwCASInEachDomain()
+  {
+    if (kMaxDomainNum < 3) GTEST_SKIP() << "two domains cannot exist with the default one";
+
+    MwCASDomain domain_a{};
+    MwCASDomain domain_b{};
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < kThreadNum; ++i) {
+      threads.emplace_back([&]() {
+        for (size_t j = 0; j < kExecNum; ++j) {
+          IncrementAll(domain_a, fields_a_);
+          IncrementAll(domain_b, fields_b_);
+        }
+      });
+    }
+    for (auto &&t : threads) t.join();
+
+    for (size_t i = 0; i < kMwCASCapacity; ++i) {
+      EXPECT_EQ(kThreadNum * kExecNum, domain_a.Read<Target>(&(fields_a_[i])));
+      EXPECT_EQ(kThreadNum * kExecNum, domain_b.Read<Target>(&(fields_b_[i])));
+    }
+  }
+
+  void
+  VerifyDestroyKeepOtherDomains()
+  {
+    if (kMaxDomainNum < 3) GTEST_SKIP() << "two domains cannot exist with the default one";
+
+    MwCASDomain domain_b{};
+    auto domain_a = std::make_unique<MwCASDomain>();
+
+    // the current thread retains finished descriptors of both the domains
+    const auto session = domain_b.CreateSession();
+    for (size_t j = 0; j < kExecNum; ++j) {
+      IncrementAll(*domain_a, fields_a_);
+      IncrementAll(domain_b, fields_b_, session);
+    }
+
+    // destroying a domain finalizes its descriptors retained by living threads
+    domain_a.reset(nullptr);
+    for (size_t i = 0; i < kMwCASCapacity; ++i) {
+      EXPECT_EQ(kExecNum, fields_a_[i]);
+    }
+
+    // the other domain is not affected by the destroyed one
+    RunInWorker([&]() {
+      for (size_t j = 0; j < kExecNum; ++j) {
+        IncrementAll(domain_b, fields_b_);
+      }
+    });
+    for (size_t i = 0; i < kMwCASCapacity; ++i) {
+      EXPECT_EQ(2 * kExecNum, domain_b.Read<Target>(&(fields_b_[i]), session));
+    }
+  }
+
+  void
+  VerifyStatisticsOfEachDomain()
+  {
+    if (kMaxDomainNum < 3) GTEST_SKIP() << "two domains cannot exist with the default one";
+
+    MwCASDomain domain_a{};
+    MwCASDomain domain_b{};
+
+    // the worker reflects its counters at its exit
+    RunInWorker([&]() {
+      for (size_t j = 0; j < kExecNum; ++j) {
+        IncrementAll(domain_a, fields_a_);
+      }
+    });
+
+    const auto stats_a = domain_a.GetStatistics();
+    EXPECT_EQ(kExecNum, stats_a.success_num);
+    EXPECT_EQ(kExecNum, domain_a.GetPoolStatistics().get_num);
+
+    const auto stats_b = domain_b.GetStatistics();
+    EXPECT_EQ(0, stats_b.success_num);
+    EXPECT_EQ(0, domain_b.GetPoolStatistics().get_num);
+  }
+
+  template <size_t kWordNum>
+  void
+  VerifyMwCASWithFixedTargets(std::integral_constant<size_t, kWordNum>)
+  {
+    if (kMaxDomainNum < 2) GTEST_SKIP() << "no domain can exist with the default one";
+    MwCASDomain domain{};
+    auto *addr_0 = &(fields_a_[0]);
+    auto *addr_1 = &(fields_a_[1]);
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < kThreadNum; ++i) {
+      threads.emplace_back([&]() {
+        for (size_t j = 0; j < kExecNum; ++j) {
+          const auto session = domain.CreateSession();
+          while (true) {
+            const auto cur_0 = domain.Read<Target>(addr_0, session);
+            const auto cur_1 = domain.Read<Target>(addr_1, session);
+            if (domain.MwCAS(session, MwCASTarget{addr_0, cur_0, cur_0 + 1},
+                             MwCASTarget{addr_1, cur_1, cur_1 + 1})) {
+              break;
+            }
+          }
+        }
+      });
+    }
+    for (auto &&t : threads) t.join();
+
+    EXPECT_EQ(kThreadNum * kExecNum, domain.Read<Target>(addr_0));
+    EXPECT_EQ(kThreadNum * kExecNum, domain.Read<Target>(addr_1));
+    EXPECT_EQ(kThreadNum * kExecNum, domain.GetStatistics().success_num);
+  }
+
+  void
+  VerifyConstructWithTooManyDomains()
+  {
+    for (size_t loop = 0; loop < 2; ++loop) {
+      // the default domain uses one ID
+      std::vector<std::unique_ptr<MwCASDomain>> domains{};
+      for (size_t i = 1; i < kMaxDomainNum; ++i) {
+        domains.emplace_back(std::make_unique<MwCASDomain>());
+      }
+      EXPECT_THROW(MwCASDomain{}, std::runtime_error);
+
+      if constexpr (kMaxDomainNum > 1) {
+        // a reused ID starts with empty counters
+        EXPECT_EQ(0, domains.back()->GetStatistics().success_num);
+        IncrementAll(*domains.back(), fields_a_);
+        EXPECT_EQ(1, domains.back()->GetStatistics().success_num);
+      }
+    }
+  }
+
+ private:
+  /*################################################################################################
+   * Internal utility functions
+   *##############################################################################################*/
+
+  template <class... Session>
+  static void
+  IncrementAll(  //
+      const MwCASDomain &domain,
+      Target *fields,
+      const Session &...session)
+  {
+    while (true) {
+      auto *desc = domain.GetDescriptor();
+      for (size_t i = 0; i < kMwCASCapacity; ++i) {
+        auto *addr = &(fields[i]);
+        const auto cur_val = domain.Read<Target>(addr, session...);
+        desc->AddMwCASTarget(addr, cur_val, cur_val + 1);
+      }
+      if (desc->MwCAS(session...)) return;
+    }
+  }
+
+  /*################################################################################################
+   * Internal member variables
+   *##############################################################################################*/
+
+  Target fields_a_[kMwCASCapacity]{};
+
+  Target fields_b_[kMwCASCapacity]{};
+};
+
+/*##################################################################################################
+ * Unit test definitions
+ *################################################################################################*/
+
+TEST_F(MwCASDomainFixture, MwCASInEachDomainCorrectlyIncrementTargets)
+{  //
+  VerifyMwCASInEachDomain();
+}
+
+TEST_F(MwCASDomainFixture, DestroyFinalizeRetainedDescriptorsAndKeepOtherDomains)
+{  //
+  VerifyDestroyKeepOtherDomains();
+}
+
+TEST_F(MwCASDomainFixture, GetStatisticsReportEventsOfEachDomain)
+{  //
+  VerifyStatisticsOfEachDomain();
+}
+
+TEST_F(MwCASDomainFixture, MwCASWithFixedTargetsCorrectlyIncrementTargets)
+{  //
+  RunIfCapacityAllows<2>([&](auto word_num) { VerifyMwCASWithFixedTargets(word_num); });
+}
+
+TEST_F(MwCASDomainFixture, ConstructWithTooManyDomainsThrowException)
+{  //
+  VerifyConstructWithTooManyDomains();
+}
+
+}  // namespace dbgroup::atomic::aopt::test
@@ -0,0 +1,208 @@
+/*
+ * Copyright 2021 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// run the multi-node paths on any host
+#ifndef MWCAS_AOPT_TEST_NUMA_NODE_NUM
+#define MWCAS_AOPT_TEST_NUMA_NODE_NUM 2
+#endif
+
+#include "aopt/component/numa_utility.hpp"
+
+#include <array>
+#include <thread>
+#include <vector>
+
+#include "aopt/component/descriptor_base.hpp"
+#include "aopt/component/descriptor_pool.hpp"
+#include "gtest/gtest.h"
+
+namespace dbgroup::atomic::aopt::component::test
+{
+/**
+ * @brief A dummy descriptor to be cached.
+ *
+ */
+struct alignas(kCacheLineSize) DummyDescriptor {
+  uint64_t data{0};
+};
+
+/**
+ * @brief A dummy GC to provide reclaimed pages on given NUMA nodes.
+ *
+ */
+class DummyGC
+{
+ public:
+  ~DummyGC()
+  {
+    for (auto *page : pages_) {
+      FreeOnNode<sizeof(DummyDescriptor)>(page);
+    }
+  }
+
+  template <class T>
+  auto
+  GetPageIfPossible()  //
+      -> void *
+  {
+    if (pages_.empty()) return nullptr;
+
+    auto *page = pages_.back();
+    pages_.pop_back();
+    return page;
+  }
+
+  void
+  AddPage(const size_t node)
+  {
+    const auto cur_node = GetFakeNUMANode();
+    GetFakeNUMANode() = node;
+    pages_.emplace_back(AllocateOnNode<sizeof(DummyDescriptor)>());
+    GetFakeNUMANode() = cur_node;
+  }
+
+ private:
+  std::vector<void *> pages_{};
+};
+
+class NUMAUtilityFixture : public ::testing::Test
+{
+ protected:
+  /*################################################################################################
+   * Internal type aliases
+   *##############################################################################################*/
+
+  using Pool_t = DescriptorPool<DummyDescriptor>;
+
+  /*################################################################################################
+   * Internal constants
+   *##############################################################################################*/
+
+  static constexpr size_t kPageSize = sizeof(DummyDescriptor);
+
+  /*################################################################################################
+   * Setup/Teardown
+   *##############################################################################################*/
+
+  void
+  SetUp() override
+  {
+    GetFakeNUMANode() = 0;
+  }
+
+  void
+  TearDown() override
+  {
+    GetFakeNUMANode() = 0;
+  }
+
+  /*################################################################################################
+   * Functions for verification
+   *##############################################################################################*/
+
+  void
+  VerifyPagesAreCarvedOutOfNodeSlabs()
+  {
+    std::array<void *, 2> pages{};
+    for (size_t node = 0; node < 2; ++node) {
+      GetFakeNUMANode() = node;
+      pages[node] = AllocateOnNode<kPageSize>();
+      EXPECT_EQ(0UL, reinterpret_cast<uintptr_t>(pages[node]) % kPageSize);
+      EXPECT_EQ(node, GetNUMANodeOf(pages[node]));
+    }
+
+    // a page released by a remote thread returns to the slabs of its own node
+    GetFakeNUMANode() = 0;
+    FreeOnNode<kPageSize>(pages[1]);
+    auto *local = AllocateOnNode<kPageSize>();
+    EXPECT_NE(pages[1], local);
+    EXPECT_EQ(0UL, GetNUMANodeOf(local));
+
+    GetFakeNUMANode() = 1;
+    EXPECT_EQ(pages[1], AllocateOnNode<kPageSize>());
+
+    FreeOnNode<kPageSize>(pages[0]);
+    FreeOnNode<kPageSize>(pages[1]);
+    FreeOnNode<kPageSize>(local);
+  }
+
+  void
+  VerifyDescriptorPagesAreAllocatedOnCurrentNode()
+  {
+    GetFakeNUMANode() = 1;
+    auto *page = new DescriptorPage{};
+    EXPECT_EQ(1UL, GetNUMANodeOf(page));
+    delete page;
+
+    // the released page is reused on the same node
+    auto *reused = new DescriptorPage{};
+    EXPECT_EQ(static_cast<void *>(page), static_cast<void *>(reused));
+    delete reused;
+  }
+
+  void
+  VerifyRemotePagesArePassedToTheirNodes()
+  {
+    DummyGC gc{};
+    gc.AddPage(1);
+    const auto before = Pool_t::GetStatistics();
+
+    // a thread on node 0 passes a reclaimed page on node 1 to the shared pool of node 1
+    void *local{};
+    {
+      Pool_t pool{};
+      local = pool.Get(&gc);
+      EXPECT_EQ(0UL, GetNUMANodeOf(local));
+      pool.Release(new (local) DummyDescriptor{});
+    }
+    const auto mid = Pool_t::GetStatistics();
+    EXPECT_EQ(before.remote_num + 1, mid.remote_num);
+    EXPECT_EQ(before.alloc_num + 1, mid.alloc_num);
+
+    // a thread on node 1 reuses the page without allocation
+    std::thread{[&]() {
+      GetFakeNUMANode() = 1;
+      Pool_t pool{};
+      auto *page = pool.Get(&gc);
+      EXPECT_EQ(1UL, GetNUMANodeOf(page));
+      pool.Release(new (page) DummyDescriptor{});
+    }}.join();
+    const auto after = Pool_t::GetStatistics();
+    EXPECT_LT(mid.node_reuse_num, after.node_reuse_num);
+    EXPECT_EQ(mid.alloc_num, after.alloc_num);
+  }
+};
+
+/*--------------------------------------------------------------------------------------------------
+ * Public utility tests
+ *------------------------------------------------------------------------------------------------*/
+
+TEST_F(NUMAUtilityFixture, AllocateOnNodeCarvePagesOutOfSlabsOfCurrentNode)
+{  //
+  VerifyPagesAreCarvedOutOfNodeSlabs();
+}
+
+TEST_F(NUMAUtilityFixture, NewDescriptorPageAllocatePageOnCurrentNode)
+{  //
+  VerifyDescriptorPagesAreAllocatedOnCurrentNode();
+}
+
+TEST_F(NUMAUtilityFixture, GetWithRemotePagesPassThemToTheirNodes)
+{  //
+  VerifyRemotePagesArePassedToTheirNodes();
+}
+
+}  // namespace dbgroup::atomic::aopt::component::test
@@ -0,0 +1,230 @@
+/*
+ * Copyright 2021 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// this test always counts events regardless of build options
+#ifndef MWCAS_AOPT_ENABLE_STATISTICS
+#define MWCAS_AOPT_ENABLE_STATISTICS
+#endif
+
+#include "aopt/component/statistics.hpp"
+
+#include <algorithm>
+#include <array>
+#include <thread>
+#include <vector>
+
+#include "aopt/aopt_descriptor.hpp"
+#include "common.hpp"
+#include "gtest/gtest.h"
+
+namespace dbgroup::atomic::aopt::component::test
+{
+class StatisticsFixture : public ::testing::Test
+{
+ protected:
+  /*################################################################################################
+   * Setup/Teardown
+   *##############################################################################################*/
+
+  void
+  SetUp() override
+  {
+    AOPTDescriptor<>::StartGC();
+  }
+
+  void
+  TearDown() override
+  {
+    AOPTDescriptor<>::StopGC();
+  }
+
+  /*################################################################################################
+   * Functions for verification
+   *##############################################################################################*/
+
+  void
+  VerifyCollectAggregatesCounters()
+  {
+    const auto before = Statistics::Collect(kDefaultDomainID);
+
+    // exited threads leave their slots, which are reused by following threads
+    for (size_t loop = 0; loop < 2; ++loop) {
+      std::vector<std::thread> threads;
+      for (size_t i = 0; i < kThreadNum; ++i) {
+        threads.emplace_back([i]() {
+          for (size_t j = 0; j < kExecNum; ++j) {
+            Statistics::Add(kDefaultDomainID, OPERATION_RETRY);
+          }
+          Statistics::UpdateMax(kDefaultDomainID, MAX_FINALIZE_SIZE, i + 1);
+        });
+      }
+      for (auto &&t : threads) t.join();
+    }
+
+    const auto after = Statistics::Collect(kDefaultDomainID);
+    EXPECT_EQ(before.retry_num + 2 * kThreadNum * kExecNum, after.retry_num);
+    EXPECT_LE(kThreadNum, after.max_finalize_size);
+  }
+
+  void
+  VerifyMwCASCountsOutcomes()
+  {
+    const auto before = Statistics::Collect(kDefaultDomainID);
+
+    RunInWorker([&]() {
+      for (size_t i = 0; i < kExecNum; ++i) {
+        auto *desc = AOPTDescriptor<>::GetDescriptor();
+        for (size_t j = 0; j < kMwCASCapacity; ++j) {
+          desc->AddMwCASTarget(&(target_fields_[j]), Target{i}, Target{i + 1});
+        }
+        EXPECT_TRUE(desc->MwCAS());
+      }
+
+      // the expected value is outdated
+      auto *desc = AOPTDescriptor<>::GetDescriptor();
+      desc->AddMwCASTarget(&(target_fields_[0]), Target{0}, Target{1});
+      EXPECT_FALSE(desc->MwCAS());
+    });
+
+    // the worker finalizes all of its descriptors at its exit
+    const auto after = AOPTDescriptor<>::GetStatistics();
+    EXPECT_EQ(before.success_num + kExecNum, after.success_num);
+    EXPECT_EQ(before.failure_num + 1, after.failure_num);
+    if constexpr (kMwCASCapacity > 1) {
+      // single-word CAS operations do not use finalization
+      EXPECT_EQ(before.finalized_desc_num + kExecNum, after.finalized_desc_num);
+      EXPECT_LE(std::min(kExecNum, kMaxFinishedDescriptors), after.max_finalize_size);
+    }
+  }
+
+  void
+  VerifyOverlappedMwCASBoundHelpDepth()
+  {
+    // each MwCAS shifts its targets by one word, so descriptors block each other in a chain
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < kThreadNum; ++i) {
+      threads.emplace_back([&, i]() {
+        for (size_t j = 0; j < kExecNum; ++j) {
+          const auto begin = (i + j) % kMwCASCapacity;
+          while (true) {
+            auto *desc = AOPTDescriptor<>::GetDescriptor();
+            for (size_t k = begin; k < begin + kMwCASCapacity; ++k) {
+              auto *addr = &(chained_fields_[k]);
+              const auto cur_val = AOPTDescriptor<>::Read<Target>(addr);
+              desc->AddMwCASTarget(addr, cur_val, cur_val + 1);
+            }
+            if (desc->MwCAS()) break;
+          }
+        }
+      });
+    }
+    for (auto &&t : threads) t.join();
+
+    Target sum = 0;
+    for (auto &&target : chained_fields_) {
+      sum += target;
+    }
+    EXPECT_EQ(kThreadNum * kExecNum * kMwCASCapacity, sum);
+    EXPECT_LE(AOPTDescriptor<>::GetStatistics().max_help_depth, kMaxHelpDepth);
+  }
+
+  void
+  VerifyMwCASUpdateGetDescriptorsOnlyForPublishedAttempts()
+  {
+    std::array<void *, kMwCASCapacity> addrs{};
+    for (size_t i = 0; i < kMwCASCapacity; ++i) {
+      addrs[i] = &(target_fields_[i]);
+    }
+    auto increment = [](const std::array<Target, kMwCASCapacity> &cur_vals) {
+      auto new_vals = cur_vals;
+      for (auto &&val : new_vals) ++val;
+      return new_vals;
+    };
+
+    const auto before = Statistics::Collect(kDefaultDomainID);
+    const auto get_num = AOPTDescriptor<>::GetPoolStatistics().get_num;
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < kThreadNum; ++i) {
+      threads.emplace_back([&]() {
+        for (size_t j = 0; j < kExecNum; ++j) {
+          MwCASUpdate<Target>(addrs, increment);
+        }
+      });
+    }
+    for (auto &&t : threads) t.join();
+
+    // only failed attempts after publishing descriptors need new descriptors
+    const auto after = Statistics::Collect(kDefaultDomainID);
+    auto published_failure_num = 0UL;
+    if constexpr (kMwCASCapacity > 1) {
+      // failed single-word CAS operations are never published
+      published_failure_num = after.failure_num - before.failure_num;
+      published_failure_num -= after.pre_validation_failure_num - before.pre_validation_failure_num;
+      published_failure_num -= after.unpublished_failure_num - before.unpublished_failure_num;
+    }
+    EXPECT_EQ(before.success_num + kThreadNum * kExecNum, after.success_num);
+    EXPECT_EQ(before.retry_num + after.failure_num - before.failure_num, after.retry_num);
+    EXPECT_EQ(get_num + kThreadNum * kExecNum + published_failure_num,
+              AOPTDescriptor<>::GetPoolStatistics().get_num);
+  }
+
+ private:
+  /*################################################################################################
+   * Internal constants
+   *##############################################################################################*/
+
+  static constexpr size_t kExecNum = 1e3;
+
+  /*################################################################################################
+   * Internal type aliases
+   *##############################################################################################*/
+
+  using Target = uint64_t;
+
+  /*################################################################################################
+   * Internal member variables
+   *##############################################################################################*/
+
+  Target target_fields_[kMwCASCapacity]{};
+
+  Target chained_fields_[2 * kMwCASCapacity]{};
+};
+
+/*--------------------------------------------------------------------------------------------------
+ * Public utility tests
+ *------------------------------------------------------------------------------------------------*/
+
+TEST_F(StatisticsFixture, CollectAfterMultiThreadsAggregateTheirCounters)
+{  //
+  VerifyCollectAggregatesCounters();
+}
+
+TEST_F(StatisticsFixture, MwCASWithSingleThreadCountItsOutcomes)
+{  //
+  VerifyMwCASCountsOutcomes();
+}
+
+TEST_F(StatisticsFixture, MwCASUpdateWithMultiThreadsGetDescriptorsOnlyForPublishedAttempts)
+{  //
+  VerifyMwCASUpdateGetDescriptorsOnlyForPublishedAttempts();
+}
+
+TEST_F(StatisticsFixture, OverlappedMwCASWithMultiThreadsBoundHelpingDepth)
+{  //
+  VerifyOverlappedMwCASBoundHelpDepth();
+}
+
+}  // namespace dbgroup::atomic::aopt::component::test
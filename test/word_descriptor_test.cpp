@@ -33,7 +33,6 @@ class WordDescriptorFixture : public ::testing::Test
   void
   SetUp() override
   {
-    dummy_aopt_desc_ = nullptr;
     if constexpr (std::is_same_v<Target, uint64_t *>) {
       old_val_ = new uint64_t{1};
       new_val_ = new uint64_t{2};
@@ -43,7 +42,7 @@ class WordDescriptorFixture : public ::testing::Test
     }
     target_ = old_val_;
 
-    word_desc_ = WordDescriptor{&target_, old_val_, new_val_, dummy_aopt_desc_};
+    word_desc_ = WordDescriptor{&target_, old_val_, new_val_};
   }
 
   void
@@ -78,6 +77,22 @@ class WordDescriptorFixture : public ::testing::Test
     }
   }
 
+  void
+  VerifyUpdateDirectly(const bool expect_fail)
+  {
+    MwCASField expected{(expect_fail) ? new_val_ : old_val_, false};
+
+    const bool success = word_desc_.UpdateDirectly(expected);
+
+    if (expect_fail) {
+      EXPECT_FALSE(success);
+      EXPECT_EQ(old_val_, target_);
+    } else {
+      EXPECT_TRUE(success);
+      EXPECT_EQ(new_val_, target_);
+    }
+  }
+
   void
   VerifyCompleteMwCAS(const bool mwcas_success)
   {
@@ -98,7 +113,6 @@ class WordDescriptorFixture : public ::testing::Test
    * Internal member variables
    *##############################################################################################*/
 
-  void *dummy_aopt_desc_{};
   WordDescriptor word_desc_{};
 
   Target target_{};
@@ -127,6 +141,16 @@ TYPED_TEST(WordDescriptorFixture, EmbedDescriptorWithUnexpectedValueFail)
   TestFixture::VerifyEmbedDescriptor(true);
 }
 
+TYPED_TEST(WordDescriptorFixture, UpdateDirectlyWithExpectedValueUpdateToDesiredValue)
+{
+  TestFixture::VerifyUpdateDirectly(false);
+}
+
+TYPED_TEST(WordDescriptorFixture, UpdateDirectlyWithUnexpectedValueFail)
+{
+  TestFixture::VerifyUpdateDirectly(true);
+}
+
 TYPED_TEST(WordDescriptorFixture, CompleteMwCASWithSucceededFlagUpdateToDesiredValue)
 {
   TestFixture::VerifyCompleteMwCAS(true);